@@ -0,0 +1,118 @@
+#include "corpora.h"
+#include <benchmark/benchmark.h>
+#include <figcone_shoal/parser.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace shoal_benchmarks {
+
+namespace {
+
+constexpr auto smallCorpusSize = std::size_t{64 * 1024};
+constexpr auto largeCorpusSize = std::size_t{4 * 1024 * 1024};
+
+std::filesystem::path writeCorpusFile(const std::string& corpus)
+{
+    const auto path = std::filesystem::temp_directory_path() / "figcone_shoal_benchmark.shoal";
+    auto file = std::ofstream{path, std::ios::binary};
+    file << corpus;
+    return path;
+}
+
+void setProcessedBytes(benchmark::State& state, const std::string& corpus)
+{
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * corpus.size()));
+    state.counters["corpus_bytes"] = static_cast<double>(corpus.size());
+}
+
+void parseBuffer(benchmark::State& state, Workload workload, LineEnding lineEnding)
+{
+    const auto corpus = makeCorpus(workload, static_cast<std::size_t>(state.range(0)), lineEnding);
+    auto parser = figcone::shoal::Parser{};
+    for (auto _ : state) {
+        auto tree = parser.parse(std::string_view{corpus});
+        benchmark::DoNotOptimize(tree);
+    }
+    setProcessedBytes(state, corpus);
+}
+
+void parseStringStream(benchmark::State& state, Workload workload, LineEnding lineEnding)
+{
+    const auto corpus = makeCorpus(workload, static_cast<std::size_t>(state.range(0)), lineEnding);
+    auto parser = figcone::shoal::Parser{};
+    auto stream = std::istringstream{corpus};
+    for (auto _ : state) {
+        stream.clear();
+        stream.seekg(0);
+        auto tree = parser.parse(stream);
+        benchmark::DoNotOptimize(tree);
+    }
+    setProcessedBytes(state, corpus);
+}
+
+void parseFileStream(benchmark::State& state, Workload workload, LineEnding lineEnding)
+{
+    const auto corpus = makeCorpus(workload, static_cast<std::size_t>(state.range(0)), lineEnding);
+    const auto path = writeCorpusFile(corpus);
+    auto parser = figcone::shoal::Parser{};
+    for (auto _ : state) {
+        auto file = std::ifstream{path, std::ios::binary};
+        auto tree = parser.parse(file);
+        benchmark::DoNotOptimize(tree);
+    }
+    setProcessedBytes(state, corpus);
+    std::filesystem::remove(path);
+}
+
+void parseMappedFile(benchmark::State& state, Workload workload, LineEnding lineEnding)
+{
+    const auto corpus = makeCorpus(workload, static_cast<std::size_t>(state.range(0)), lineEnding);
+    const auto path = writeCorpusFile(corpus);
+    auto parser = figcone::shoal::Parser{};
+    for (auto _ : state) {
+        auto tree = parser.parseFile(path);
+        benchmark::DoNotOptimize(tree);
+    }
+    setProcessedBytes(state, corpus);
+    std::filesystem::remove(path);
+}
+
+void applyCorpusSizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->Arg(smallCorpusSize)->Arg(largeCorpusSize)->Unit(benchmark::kMicrosecond);
+}
+
+} //namespace
+
+// Workloads parsed from the in-memory buffer
+BENCHMARK_CAPTURE(parseBuffer, flat_params, Workload::FlatParams, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, deep_nesting, Workload::DeepNesting, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, large_node_list, Workload::LargeNodeList, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, multiline_lists, Workload::MultilineLists, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, long_quoted_strings, Workload::LongQuotedStrings, LineEnding::LF)
+        ->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, comment_heavy, Workload::CommentHeavy, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, synthetic, Workload::Synthetic, LineEnding::LF)->Apply(applyCorpusSizes);
+
+// Line endings
+BENCHMARK_CAPTURE(parseBuffer, flat_params_crlf, Workload::FlatParams, LineEnding::CRLF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, flat_params_cr, Workload::FlatParams, LineEnding::CR)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, multiline_lists_crlf, Workload::MultilineLists, LineEnding::CRLF)
+        ->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseBuffer, comment_heavy_crlf, Workload::CommentHeavy, LineEnding::CRLF)->Apply(applyCorpusSizes);
+
+// Input sources
+BENCHMARK_CAPTURE(parseStringStream, flat_params, Workload::FlatParams, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseStringStream, large_node_list, Workload::LargeNodeList, LineEnding::LF)
+        ->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseStringStream, synthetic, Workload::Synthetic, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseStringStream, flat_params_crlf, Workload::FlatParams, LineEnding::CRLF)
+        ->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseFileStream, flat_params, Workload::FlatParams, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseFileStream, large_node_list, Workload::LargeNodeList, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseMappedFile, flat_params, Workload::FlatParams, LineEnding::LF)->Apply(applyCorpusSizes);
+BENCHMARK_CAPTURE(parseMappedFile, large_node_list, Workload::LargeNodeList, LineEnding::LF)->Apply(applyCorpusSizes);
+
+} //namespace shoal_benchmarks
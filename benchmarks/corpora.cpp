@@ -0,0 +1,186 @@
+#include "corpora.h"
+#include <synthconfig.h>
+#include <string_view>
+
+namespace shoal_benchmarks {
+
+namespace {
+
+void appendLine(std::string& result, std::size_t indent, std::string_view line)
+{
+    result.append(indent, ' ');
+    result.append(line);
+    result += '\n';
+}
+
+std::string makeFlatParams(std::size_t targetSize)
+{
+    auto result = std::string{};
+    for (auto i = std::size_t{}; result.size() < targetSize; ++i) {
+        const auto name = "param" + std::to_string(i);
+        switch (i % 4) {
+        case 0:
+            appendLine(result, 0, name + " = " + std::to_string(i * 7919));
+            break;
+        case 1:
+            appendLine(result, 0, name + " = value_" + std::to_string(i));
+            break;
+        case 2:
+            appendLine(result, 0, name + " = '" + std::to_string(i) + " quoted'");
+            break;
+        default:
+            appendLine(result, 0, name + " = " + (i % 8 == 3 ? "true" : "false"));
+        }
+    }
+    return result;
+}
+
+// Chains of nested nodes closed by every kind of closing token
+std::string makeDeepNesting(std::size_t targetSize)
+{
+    constexpr auto depth = std::size_t{32};
+    auto result = std::string{};
+    for (auto block = std::size_t{}; result.size() < targetSize; ++block) {
+        const auto blockName = "block" + std::to_string(block);
+        appendLine(result, 0, "#" + blockName + ":");
+        for (auto level = std::size_t{1}; level < depth; ++level) {
+            appendLine(result, level * 2, "value = " + std::to_string(level));
+            appendLine(result, level * 2, "#level" + std::to_string(level) + ":");
+        }
+        appendLine(result, depth * 2, "value = " + std::to_string(depth));
+        switch (block % 3) {
+        case 0:
+            appendLine(result, 0, "---");
+            break;
+        case 1:
+            appendLine(result, 0, "--" + blockName);
+            break;
+        default:
+            for (auto level = std::size_t{}; level < depth; ++level)
+                appendLine(result, 0, "-");
+        }
+    }
+    return result;
+}
+
+std::string makeLargeNodeList(std::size_t targetSize)
+{
+    auto result = std::string{"#items:\n"};
+    for (auto i = std::size_t{}; result.size() < targetSize; ++i) {
+        appendLine(result, 0, "###");
+        appendLine(result, 2, "id = " + std::to_string(i));
+        appendLine(result, 2, "name = item_" + std::to_string(i));
+        appendLine(result, 2, "tags = [a, b, c]");
+        appendLine(result, 2, std::string{"enabled = "} + (i % 2 ? "true" : "false"));
+    }
+    return result;
+}
+
+std::string makeMultilineLists(std::size_t targetSize)
+{
+    constexpr auto listSize = std::size_t{64};
+    auto result = std::string{};
+    for (auto i = std::size_t{}; result.size() < targetSize; ++i) {
+        appendLine(result, 0, "list" + std::to_string(i) + " = [");
+        for (auto element = std::size_t{}; element < listSize; ++element) {
+            const auto value = element % 2 ? std::to_string(i * listSize + element)
+                                           : "'element " + std::to_string(element) + "'";
+            appendLine(result, 2, element + 1 < listSize ? value + "," : value);
+        }
+        appendLine(result, 0, "]");
+    }
+    return result;
+}
+
+std::string makeLongQuotedStrings(std::size_t targetSize)
+{
+    constexpr auto stringSize = std::size_t{1024};
+    const auto words = std::string_view{"lorem ipsum; dolor sit amet, consectetur # adipiscing - elit = "};
+    auto result = std::string{};
+    for (auto i = std::size_t{}; result.size() < targetSize; ++i) {
+        const auto quote = i % 3 == 0 ? '\'' : i % 3 == 1 ? '"' : '`';
+        auto value = std::string{};
+        while (value.size() < stringSize) {
+            value += words;
+            // Every fourth string is multiline
+            if (i % 4 == 0 && value.size() % 256 < words.size())
+                value += '\n';
+        }
+        appendLine(result, 0, "text" + std::to_string(i) + " = " + quote + value + quote);
+    }
+    return result;
+}
+
+std::string makeCommentHeavy(std::size_t targetSize)
+{
+    auto result = std::string{};
+    for (auto i = std::size_t{}; result.size() < targetSize; ++i) {
+        appendLine(result, 0, "; Description of the parameter #" + std::to_string(i));
+        appendLine(result, 0, ";   it's kept in the config for the operators, and can contain = # - ### [ ]");
+        appendLine(result, 0, "param" + std::to_string(i) + " = " + std::to_string(i) + " ; trailing comment");
+        if (i % 8 == 7)
+            appendLine(result, 0, "");
+    }
+    return result;
+}
+
+std::string makeSynthetic(std::size_t targetSize, LineEnding lineEnding)
+{
+    auto options = shoal_synth::SynthOptions{};
+    options.targetSize = targetSize;
+    switch (lineEnding) {
+    case LineEnding::LF:
+        options.lineEnding = shoal_synth::LineEnding::LF;
+        break;
+    case LineEnding::CRLF:
+        options.lineEnding = shoal_synth::LineEnding::CRLF;
+        break;
+    case LineEnding::CR:
+        options.lineEnding = shoal_synth::LineEnding::CR;
+        break;
+    }
+    return shoal_synth::generateConfig(options);
+}
+
+std::string convertLineEndings(const std::string& text, LineEnding lineEnding)
+{
+    if (lineEnding == LineEnding::LF)
+        return text;
+
+    auto result = std::string{};
+    result.reserve(text.size() * 2);
+    for (auto ch : text) {
+        if (ch != '\n')
+            result += ch;
+        else if (lineEnding == LineEnding::CRLF)
+            result += "\r\n";
+        else
+            result += '\r';
+    }
+    return result;
+}
+
+} //namespace
+
+std::string makeCorpus(Workload workload, std::size_t targetSize, LineEnding lineEnding)
+{
+    switch (workload) {
+    case Workload::FlatParams:
+        return convertLineEndings(makeFlatParams(targetSize), lineEnding);
+    case Workload::DeepNesting:
+        return convertLineEndings(makeDeepNesting(targetSize), lineEnding);
+    case Workload::LargeNodeList:
+        return convertLineEndings(makeLargeNodeList(targetSize), lineEnding);
+    case Workload::MultilineLists:
+        return convertLineEndings(makeMultilineLists(targetSize), lineEnding);
+    case Workload::LongQuotedStrings:
+        return convertLineEndings(makeLongQuotedStrings(targetSize), lineEnding);
+    case Workload::CommentHeavy:
+        return convertLineEndings(makeCommentHeavy(targetSize), lineEnding);
+    case Workload::Synthetic:
+        return makeSynthetic(targetSize, lineEnding);
+    }
+    return {};
+}
+
+} //namespace shoal_benchmarks
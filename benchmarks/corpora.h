@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace shoal_benchmarks {
+
+enum class Workload {
+    FlatParams,
+    DeepNesting,
+    LargeNodeList,
+    MultilineLists,
+    LongQuotedStrings,
+    CommentHeavy,
+    // Mix of all the constructs from the synthetic config generator
+    Synthetic
+};
+
+enum class LineEnding {
+    LF,
+    CRLF,
+    CR
+};
+
+// Builds a valid shoal document of the workload's shape, which is at least targetSize bytes long.
+// The content depends only on the arguments, so the results of different runs are comparable.
+std::string makeCorpus(Workload workload, std::size_t targetSize, LineEnding lineEnding = LineEnding::LF);
+
+} //namespace shoal_benchmarks
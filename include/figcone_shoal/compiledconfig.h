@@ -0,0 +1,91 @@
+#ifndef FIGCONE_SHOAL_COMPILEDCONFIG_H
+#define FIGCONE_SHOAL_COMPILEDCONFIG_H
+
+#include <figcone_tree/streamposition.h>
+#include <figcone_tree/tree.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal {
+namespace detail {
+class CompiledImage;
+class MappedFile;
+} //namespace detail
+
+/// Param of a compiled config, the strings point into the image and are valid while the CompiledConfig is alive
+class CompiledParam {
+public:
+    std::string_view name() const;
+    bool isList() const;
+    StreamPosition position() const;
+
+    /// Value of a param that isn't a list
+    std::string_view value() const;
+    std::vector<std::string_view> valueList() const;
+
+private:
+    CompiledParam(const detail::CompiledImage& image, std::uint32_t index);
+    friend class CompiledNode;
+
+    const detail::CompiledImage* image_;
+    std::uint32_t index_;
+};
+
+/// Node of a compiled config, it has the same shape as figcone::TreeNode but reads the image directly.
+/// Names of child nodes and params are looked up with binary search.
+class CompiledNode {
+public:
+    /// List elements have the name of their list
+    std::string_view name() const;
+    bool isList() const;
+    StreamPosition position() const;
+
+    std::size_t paramsCount() const;
+    bool hasParam(std::string_view name) const;
+    CompiledParam param(std::string_view name) const;
+
+    std::size_t nodesCount() const;
+    bool hasNode(std::string_view name) const;
+    CompiledNode node(std::string_view name) const;
+
+    /// Number of elements of a list node
+    std::size_t size() const;
+    CompiledNode at(std::size_t index) const;
+
+private:
+    CompiledNode(const detail::CompiledImage& image, std::uint32_t index);
+    std::uint32_t findParam(std::string_view name) const;
+    std::uint32_t findNode(std::string_view name) const;
+    friend class CompiledConfig;
+
+    const detail::CompiledImage* image_;
+    std::uint32_t index_;
+};
+
+/// Result of Parser::loadCompiled(), the validated image of a config compiled by Parser::compile()
+class CompiledConfig {
+public:
+    ~CompiledConfig();
+    CompiledConfig(CompiledConfig&&) noexcept;
+    CompiledConfig& operator=(CompiledConfig&&) noexcept;
+
+    CompiledNode root() const;
+    /// Builds figcone::Tree with the content of the image. Like in the trees built by Parser::parse(),
+    /// the nodes keep their positions and the params don't have them
+    Tree tree() const;
+
+private:
+    CompiledConfig(std::unique_ptr<detail::MappedFile> file, std::string_view data);
+    friend class Parser;
+
+    std::unique_ptr<detail::MappedFile> file_;
+    std::unique_ptr<detail::CompiledImage> image_;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_COMPILEDCONFIG_H
@@ -0,0 +1,81 @@
+#ifndef FIGCONE_SHOAL_CONFIGWATCHER_H
+#define FIGCONE_SHOAL_CONFIGWATCHER_H
+
+#ifdef __linux__
+
+#include "parser.h"
+#include <figcone_tree/errors.h>
+#include <figcone_tree/tree.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace figcone::shoal {
+
+/// Watches shoal config files with inotify and publishes a new figcone::Tree when the content of a file changes.
+/// The directories of the files are watched, so the files replaced by renaming (e.g. by text editors) are
+/// detected too. Bursts of writes are reported once, and the files are parsed again only if their content differs
+/// from the previously read one.
+class ConfigWatcher {
+    struct WatchedFile {
+        std::filesystem::path path;
+        int directoryWatch;
+        std::string fileName;
+        std::size_t contentSize = 0;
+        std::size_t contentHash = 0;
+        bool isChanged = false;
+        std::chrono::steady_clock::time_point changeTime;
+    };
+
+public:
+    using TreeHandler = std::function<void(const std::filesystem::path& path, Tree tree)>;
+    using ErrorHandler = std::function<void(const std::filesystem::path& path, const ConfigError& error)>;
+
+    /// The handlers are invoked on the thread processing the events, the parser's settings are used to parse the files.
+    /// Exceptions thrown while reloading a file, including the ones of the tree handler, are passed to the error
+    /// handler as ConfigError.
+    explicit ConfigWatcher(TreeHandler treeHandler, ErrorHandler errorHandler = {}, Parser parser = {});
+    ~ConfigWatcher();
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+    ConfigWatcher(ConfigWatcher&&) = delete;
+    ConfigWatcher& operator=(ConfigWatcher&&) = delete;
+
+    /// Starts watching the file and returns its current tree. Must be called before start().
+    Tree watch(const std::filesystem::path& path);
+    /// File changes that are closer in time than the delay are processed as one change, 100ms by default
+    void setDebounceDelay(std::chrono::milliseconds delay);
+
+    /// Waits up to timeout for the changes of the watched files, returns after the first trees are published.
+    /// Returns the number of published trees.
+    std::size_t processEvents(std::chrono::milliseconds timeout);
+    /// Processes the events on a background thread until stop() is called or the watcher is destroyed
+    void start();
+    void stop();
+
+private:
+    void readEvents();
+    bool reload(WatchedFile& file);
+
+private:
+    TreeHandler treeHandler_;
+    ErrorHandler errorHandler_;
+    Parser parser_;
+    std::chrono::milliseconds debounceDelay_ = std::chrono::milliseconds{100};
+    std::vector<WatchedFile> files_;
+    int inotifyFd_ = -1;
+    int stopEventFd_ = -1;
+    std::atomic<bool> isStopRequested_ = false;
+    std::thread thread_;
+};
+
+} //namespace figcone::shoal
+
+#endif //__linux__
+
+#endif //FIGCONE_SHOAL_CONFIGWATCHER_H
@@ -0,0 +1,30 @@
+#ifndef FIGCONE_SHOAL_IEVENTHANDLER_H
+#define FIGCONE_SHOAL_IEVENTHANDLER_H
+
+#include "paramposition.h"
+#include <figcone_tree/streamposition.h>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal {
+
+/// Receives the structure of a shoal document while it's being parsed, without building figcone::Tree.
+/// Every onNodeBegin, onNodeListBegin and onListElement call is matched by an onNodeEnd call.
+/// Passed strings are valid only until the parsing is finished.
+class IEventHandler {
+public:
+    virtual ~IEventHandler() = default;
+    virtual void onNodeBegin(std::string_view name, const StreamPosition& position) = 0;
+    virtual void onNodeListBegin(std::string_view name, const StreamPosition& position) = 0;
+    virtual void onListElement(const StreamPosition& position) = 0;
+    virtual void onParam(std::string_view name, std::string_view value, const ParamPosition& position) = 0;
+    virtual void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position) = 0;
+    virtual void onNodeEnd() = 0;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_IEVENTHANDLER_H
@@ -0,0 +1,50 @@
+#ifndef FIGCONE_SHOAL_INCREMENTALDOCUMENT_H
+#define FIGCONE_SHOAL_INCREMENTALDOCUMENT_H
+
+#include <figcone_tree/tree.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace figcone::shoal {
+class Parser;
+namespace detail {
+struct DocumentSection;
+}
+
+/// Result of Parser::parseIncremental(), keeps the parsed content of every node section and list element,
+/// so after an edit of the text only the smallest node section or list element enclosing the edited region
+/// is parsed again.
+class IncrementalDocument {
+public:
+    ~IncrementalDocument();
+    IncrementalDocument(IncrementalDocument&&) noexcept;
+    IncrementalDocument& operator=(IncrementalDocument&&) noexcept;
+
+    const std::string& text() const;
+    /// Builds figcone::Tree from the parsed content, the unchanged sections aren't parsed again
+    Tree tree() const;
+
+    /// Replaces the text, the edited region is found by comparing it with the current text.
+    /// On error, the document keeps the current text.
+    void update(std::string text);
+    /// Replaces size bytes of the text starting at offset with replacement.
+    /// On error, the document keeps the current text.
+    void update(std::size_t offset, std::size_t size, std::string_view replacement);
+    /// Size of the text parsed again by the last update
+    std::size_t reparsedSize() const;
+
+private:
+    explicit IncrementalDocument(std::string text);
+    void applyEdit(std::string text, std::size_t offset, std::size_t size, std::size_t replacementSize);
+    friend class Parser;
+
+    std::string text_;
+    std::unique_ptr<detail::DocumentSection> root_;
+    std::size_t reparsedSize_ = 0;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_INCREMENTALDOCUMENT_H
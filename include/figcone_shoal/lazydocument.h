@@ -0,0 +1,78 @@
+#ifndef FIGCONE_SHOAL_LAZYDOCUMENT_H
+#define FIGCONE_SHOAL_LAZYDOCUMENT_H
+
+#include <figcone_tree/streamposition.h>
+#include <figcone_tree/tree.h>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal {
+namespace detail {
+class LazyIndexBuilder;
+class MappedFile;
+} //namespace detail
+
+/// Config node with the known location of its content, which is parsed into figcone::TreeNode only on the first
+/// tree() call. Access to the same document isn't synchronized.
+class LazyNode {
+public:
+    /// List elements have the name of their list
+    const std::string& name() const;
+    bool isList() const;
+    const StreamPosition& position() const;
+
+    bool hasNode(std::string_view name) const;
+    const LazyNode& node(std::string_view name) const;
+    std::size_t nodesCount() const;
+
+    /// Number of elements of a list node
+    std::size_t size() const;
+    const LazyNode& at(std::size_t index) const;
+
+    /// Returns the node parsed with its params and child nodes. List nodes can't be parsed as a whole, use at().
+    const TreeNode& tree() const;
+
+private:
+    LazyNode(std::string_view data, std::string name, bool isList, const StreamPosition& position);
+    friend class detail::LazyIndexBuilder;
+
+    std::string_view data_;
+    std::string name_;
+    bool isList_;
+    StreamPosition position_;
+    // Content is parsed from the beginning of its first line, so the columns of the positions are right
+    std::size_t contentBegin_ = 0;
+    std::size_t contentEnd_ = 0;
+    int contentLine_ = 1;
+    std::map<std::string, std::unique_ptr<LazyNode>, std::less<>> nodes_;
+    std::vector<std::unique_ptr<LazyNode>> elements_;
+    mutable std::unique_ptr<Tree> tree_;
+};
+
+/// Result of Parser::parseLazy(). The whole document is read to index the locations of the nodes and to report
+/// the errors, so it costs about as much as the parsing without the tree construction, which is deferred until
+/// LazyNode::tree() is called.
+class LazyDocument {
+public:
+    ~LazyDocument();
+    LazyDocument(LazyDocument&&) noexcept;
+    LazyDocument& operator=(LazyDocument&&) noexcept;
+
+    const LazyNode& root() const;
+
+private:
+    LazyDocument(std::unique_ptr<detail::MappedFile> file, std::unique_ptr<LazyNode> root);
+    friend class detail::LazyIndexBuilder;
+
+    std::unique_ptr<detail::MappedFile> file_;
+    std::unique_ptr<LazyNode> root_;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_LAZYDOCUMENT_H
@@ -0,0 +1,30 @@
+#ifndef FIGCONE_SHOAL_PARAMPOSITION_H
+#define FIGCONE_SHOAL_PARAMPOSITION_H
+
+#include <figcone_tree/streamposition.h>
+#include <cstddef>
+
+namespace figcone::shoal {
+namespace detail {
+class Stream;
+} //namespace detail
+
+/// Position of a param passed to IEventHandler. The parser keeps only the param's offset, and its line and column
+/// are found when resolve() is called, so the handlers that don't use them don't pay for indexing the lines.
+/// It can be resolved only during the handler call.
+class ParamPosition {
+public:
+    /// Position that is already resolved, e.g. stored by a previous parsing
+    ParamPosition(const StreamPosition& position = {});
+    ParamPosition(detail::Stream& stream, std::size_t offset);
+    StreamPosition resolve() const;
+
+private:
+    StreamPosition position_;
+    detail::Stream* stream_ = nullptr;
+    std::size_t offset_ = 0;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_PARAMPOSITION_H
@@ -1,9 +1,20 @@
 #ifndef FIGCONE_SHOAL_PARSER_H
 #define FIGCONE_SHOAL_PARSER_H
 
+#include "compiledconfig.h"
+#include "ieventhandler.h"
+#include "incrementaldocument.h"
+#include "lazydocument.h"
+#include "parseresult.h"
 #include <figcone_tree/iparser.h>
 #include <figcone_tree/stringconverter.h>
 #include <figcone_tree/tree.h>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace figcone {
 template<>
@@ -20,10 +31,91 @@ struct StringConverter<bool> {
 } //namespace figcone
 
 namespace figcone::shoal {
+namespace detail {
+class Stream;
+}
+
+struct StringInterningReport {
+    std::size_t reusedStringsCount = 0;
+    std::size_t savedBytes = 0;
+};
 
 class Parser : public IParser {
 public:
     Tree parse(std::istream& stream) override;
+    Tree parse(std::string_view data);
+    Tree parseFile(const std::filesystem::path& path);
+
+    /// Returns the errors of the document instead of throwing figcone::ConfigError, the parser core doesn't use
+    /// exceptions to report them, so it's cheaper when many of the parsed documents are invalid.
+    ParseResult tryParse(std::istream& stream);
+    ParseResult tryParse(std::string_view data);
+
+    /// Reports all the errors of the document in one pass instead of stopping at the first one.
+    /// After an error the parsing resumes at the next line, which can be a param, a node header or a '###' separator,
+    /// so only the rest of the line with the error is skipped. Its content before the error is kept, e.g. a node
+    /// closed by a closing token with a misspelled name is still closed.
+    /// The tree of the content read without errors is built only if isPartialTreeRequested is true.
+    RecoveredParseResult parseWithRecovery(std::istream& stream, bool isPartialTreeRequested = true);
+    RecoveredParseResult parseWithRecovery(std::string_view data, bool isPartialTreeRequested = true);
+
+    /// Reports the document structure to the handler instead of building figcone::Tree.
+    /// Errors are reported by throwing figcone::ConfigError, the handler can also throw to stop the parsing.
+    void parse(std::istream& stream, IEventHandler& handler);
+    void parse(std::string_view data, IEventHandler& handler);
+    void parseFile(const std::filesystem::path& path, IEventHandler& handler);
+
+    /// Checks the whole document, but parses the content of its nodes only when it's requested by LazyNode::tree().
+    /// The buffer isn't copied and must stay alive while the result is used.
+    LazyDocument parseLazy(std::string_view data);
+    LazyDocument parseFileLazy(const std::filesystem::path& path);
+
+    /// Parses the text, keeping the parsed content of its node sections and list elements,
+    /// so after an edit only the section enclosing it is parsed again by IncrementalDocument::update().
+    IncrementalDocument parseIncremental(std::string text);
+
+    /// Compiles the config into a binary image with the tables of its nodes, params and strings,
+    /// which is loaded by loadCompiled() and loadCompiledFile() without parsing the text.
+    /// The image uses the byte order of the platform and is checked to be the same when it's loaded.
+    std::string compile(std::string_view data);
+    void compileFile(const std::filesystem::path& path, const std::filesystem::path& outputPath);
+    /// Validates the image and reads it in place. The buffer isn't copied and must stay alive while the result is used.
+    CompiledConfig loadCompiled(std::string_view image);
+    /// Maps the image file into memory, so only its validation depends on its size
+    CompiledConfig loadCompiledFile(const std::filesystem::path& path);
+
+    /// Makes repeated param names, node names and short values (e.g. in every element of a node list)
+    /// share the parser's transient storage instead of being stored separately.
+    /// figcone::Tree keeps its own copies of the strings, so it reduces the peak memory usage of the parsing.
+    void enableStringInterning(bool state = true);
+    /// Returns the interning statistics of the last parsing.
+    const StringInterningReport& stringInterningReport() const;
+
+    /// Makes parse(std::string_view) and parseFile() read the params and node list elements of large configs
+    /// on several threads, the structure of the config and figcone::Tree are still built on the calling thread.
+    /// Thread count of 0 or 1 disables it.
+    void enableParallelParsing(std::size_t threadCount = std::thread::hardware_concurrency());
+
+    /// Makes parseFile() store the parsing results in the directory and load them instead of parsing the files
+    /// that haven't changed, which are detected by the path, size, modification time and content hash.
+    /// Empty path disables it.
+    void enableParseCache(const std::filesystem::path& directory);
+
+private:
+    Tree parseStream(detail::Stream& stream);
+    void parseStream(detail::Stream& stream, IEventHandler& handler);
+    ParseResult tryParseStream(detail::Stream& stream);
+    Expected<void> tryParseStream(
+            detail::Stream& stream,
+            IEventHandler& handler,
+            std::vector<ParseError>* errors = nullptr);
+    RecoveredParseResult parseStreamWithRecovery(detail::Stream& stream, bool isPartialTreeRequested);
+
+private:
+    bool isStringInterningEnabled_ = false;
+    StringInterningReport stringInterningReport_;
+    std::size_t parallelParsingThreadCount_ = 0;
+    std::filesystem::path parseCacheDirectory_;
 };
 
 } //namespace figcone::shoal
@@ -0,0 +1,139 @@
+#ifndef FIGCONE_SHOAL_PARSERESULT_H
+#define FIGCONE_SHOAL_PARSERESULT_H
+
+#include <figcone_tree/streamposition.h>
+#include <figcone_tree/tree.h>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace figcone::shoal {
+
+/// Error of the document, it has the message and the position figcone::ConfigError is thrown with by Parser::parse()
+struct ParseError {
+    std::string message;
+    StreamPosition position;
+};
+
+/// Value or the error it couldn't be produced with, like std::expected.
+/// Accessing the missing value or error throws std::bad_variant_access (std::bad_optional_access for Expected<void>).
+template<typename T>
+class Expected {
+public:
+    template<
+            typename TValue = T,
+            typename = std::enable_if_t<
+                    std::is_constructible_v<T, TValue&&> &&
+                    !std::is_same_v<std::decay_t<TValue>, ParseError> &&
+                    !std::is_same_v<std::decay_t<TValue>, Expected>>>
+    Expected(TValue&& value)
+        : result_{std::in_place_index<0>, std::forward<TValue>(value)}
+    {
+    }
+
+    Expected(ParseError error)
+        : result_{std::in_place_index<1>, std::move(error)}
+    {
+    }
+
+    bool hasValue() const
+    {
+        return result_.index() == 0;
+    }
+
+    explicit operator bool() const
+    {
+        return hasValue();
+    }
+
+    T& value() &
+    {
+        return std::get<0>(result_);
+    }
+
+    const T& value() const&
+    {
+        return std::get<0>(result_);
+    }
+
+    T&& value() &&
+    {
+        return std::get<0>(std::move(result_));
+    }
+
+    T& operator*() &
+    {
+        return value();
+    }
+
+    const T& operator*() const&
+    {
+        return value();
+    }
+
+    T* operator->()
+    {
+        return &value();
+    }
+
+    const T* operator->() const
+    {
+        return &value();
+    }
+
+    const ParseError& error() const
+    {
+        return std::get<1>(result_);
+    }
+
+private:
+    std::variant<T, ParseError> result_;
+};
+
+/// Result of an operation that only can fail
+template<>
+class Expected<void> {
+public:
+    Expected() = default;
+
+    Expected(ParseError error)
+        : error_{std::move(error)}
+    {
+    }
+
+    bool hasValue() const
+    {
+        return !error_.has_value();
+    }
+
+    explicit operator bool() const
+    {
+        return hasValue();
+    }
+
+    const ParseError& error() const
+    {
+        return error_.value();
+    }
+
+private:
+    std::optional<ParseError> error_;
+};
+
+/// Result of Parser::tryParse()
+using ParseResult = Expected<Tree>;
+
+/// Result of Parser::parseWithRecovery()
+struct RecoveredParseResult {
+    /// Tree of the content that was read without errors, if it was requested
+    std::optional<Tree> tree;
+    /// Errors in the order they were found, the document is valid if it's empty
+    std::vector<ParseError> errors;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_PARSERESULT_H
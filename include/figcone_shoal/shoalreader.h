@@ -0,0 +1,65 @@
+#ifndef FIGCONE_SHOAL_SHOALREADER_H
+#define FIGCONE_SHOAL_SHOALREADER_H
+
+#include <figcone_tree/streamposition.h>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal {
+namespace detail {
+class Stream;
+class NodeReader;
+} //namespace detail
+
+enum class ReaderEvent {
+    None,
+    NodeBegin,
+    NodeListBegin,
+    ListElement,
+    Param,
+    ParamList,
+    NodeEnd,
+    DocumentEnd
+};
+
+/// Cursor over a shoal document, which reads the next structural event only when next() is called.
+/// NodeBegin, NodeListBegin and ListElement events are matched by NodeEnd events.
+/// Errors are reported by throwing figcone::ConfigError, with the same messages and positions as Parser::parse().
+/// Names and values are valid until the reader is destroyed.
+class ShoalReader {
+public:
+    /// The stream must stay alive while the reader is used
+    explicit ShoalReader(std::istream& stream);
+    /// The buffer isn't copied and must stay alive while the reader is used
+    explicit ShoalReader(std::string_view data);
+    ~ShoalReader();
+    ShoalReader(const ShoalReader&) = delete;
+    ShoalReader& operator=(const ShoalReader&) = delete;
+
+    ReaderEvent next();
+    /// Skips the rest of the node opened by the current NodeBegin, NodeListBegin or ListElement event,
+    /// including its NodeEnd event. The skipped part is still checked for errors.
+    void skipNode();
+
+    ReaderEvent event() const;
+    /// Name of the current node, list or param. ListElement events have the name of their list.
+    std::string_view name() const;
+    /// Value of the current Param event
+    std::string_view value() const;
+    /// Values of the current ParamList event
+    const std::vector<std::string_view>& valueList() const;
+    StreamPosition position() const;
+    /// Number of the currently open nodes, the root node isn't counted
+    std::size_t depth() const;
+
+private:
+    std::unique_ptr<detail::Stream> stream_;
+    std::unique_ptr<detail::NodeReader> reader_;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_SHOALREADER_H
@@ -0,0 +1,544 @@
+#ifndef FIGCONE_SHOAL_STATICCONFIG_H
+#define FIGCONE_SHOAL_STATICCONFIG_H
+
+#include <vector>
+#include <version>
+
+#if defined(__cpp_consteval) && defined(__cpp_lib_constexpr_vector) && defined(__cpp_lib_constexpr_string) &&       \
+        __cpp_lib_constexpr_string >= 201907L && defined(__cpp_nontype_template_args) &&                            \
+        __cpp_nontype_template_args >= 201911L
+#define FIGCONE_SHOAL_HAS_STATIC_CONFIG
+
+#include "staticconfigparser.h"
+#include <figcone_tree/errors.h>
+#include <figcone_tree/streamposition.h>
+#include <figcone_tree/tree.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace figcone::shoal {
+
+/// Config text passed as a template argument of parseStatic()
+template<std::size_t N>
+struct StaticConfigText {
+    consteval StaticConfigText(const char (&str)[N])
+    {
+        std::copy_n(str, N, data);
+    }
+
+    constexpr std::string_view view() const
+    {
+        return {data, N - 1};
+    }
+
+    char data[N];
+};
+
+namespace detail {
+
+struct StaticString {
+    std::size_t offset;
+    std::size_t size;
+};
+
+// Nodes are stored in breadth-first order, so the children of a node occupy a contiguous range of indices.
+// Child nodes of a node and its params are sorted by name.
+struct StaticNodeData {
+    StaticString name;
+    StaticPosition position;
+    bool isList;
+    std::size_t firstParam;
+    std::size_t paramCount;
+    std::size_t firstChild;
+    std::size_t childCount;
+};
+
+struct StaticParamData {
+    StaticString name;
+    StaticPosition position;
+    bool isList;
+    std::size_t firstValue;
+    std::size_t valueCount;
+};
+
+struct StaticConfigSize {
+    std::size_t nodeCount;
+    std::size_t paramCount;
+    std::size_t valueCount;
+    std::size_t textSize;
+};
+
+// Tables of a StaticConfig without their sizes, so the views of the config don't depend on them
+struct StaticConfigTables {
+    const StaticNodeData* nodes;
+    const StaticParamData* params;
+    const StaticString* values;
+    const char* text;
+
+    constexpr std::string_view string(const StaticString& str) const
+    {
+        return {text + str.offset, str.size};
+    }
+};
+
+// The root node has no position, it's stored as line 0
+inline StreamPosition toStreamPosition(const StaticPosition& position)
+{
+    if (position.line == 0)
+        return {};
+    return {position.line, position.column};
+}
+
+// Transient tree built during the constant evaluation
+class StaticConfigBuilder {
+public:
+    struct Param {
+        std::string name;
+        bool isList;
+        std::vector<std::string> valueList;
+        StaticPosition position;
+    };
+
+    struct Node {
+        std::string name;
+        bool isList;
+        StaticPosition position;
+        std::vector<Param> params;
+        std::vector<Node> nodes;
+    };
+
+    constexpr StaticConfigBuilder()
+        : root_{{}, false, {0, 0}, {}, {}}
+        , nodeStack_{&root_}
+    {
+    }
+
+    constexpr void onNodeBegin(std::string_view name, const StaticPosition& position)
+    {
+        addNode(name, false, position);
+    }
+
+    constexpr void onNodeListBegin(std::string_view name, const StaticPosition& position)
+    {
+        addNode(name, true, position);
+    }
+
+    constexpr void onListElement(const StaticPosition& position)
+    {
+        addNode(nodeStack_.back()->name, false, position);
+    }
+
+    // Repeated params are ignored, as figcone::Tree keeps the first one
+    constexpr void onParam(const StaticParsedParam& param, const StaticPosition& position)
+    {
+        auto& params = nodeStack_.back()->params;
+        if (std::find_if(
+                    params.begin(),
+                    params.end(),
+                    [&](const Param& storedParam)
+                    {
+                        return storedParam.name == param.name;
+                    }) == params.end())
+            params.push_back({param.name, param.isList, param.valueList, position});
+    }
+
+    constexpr void onNodeEnd()
+    {
+        nodeStack_.pop_back();
+    }
+
+    constexpr Node& root()
+    {
+        return root_;
+    }
+
+private:
+    constexpr void addNode(std::string_view name, bool isList, const StaticPosition& position)
+    {
+        auto& nodes = nodeStack_.back()->nodes;
+        nodes.push_back({std::string{name}, isList, position, {}, {}});
+        nodeStack_.push_back(&nodes.back());
+    }
+
+private:
+    Node root_;
+    std::vector<Node*> nodeStack_;
+};
+
+struct StaticConfigLayout {
+    std::vector<StaticNodeData> nodes;
+    std::vector<StaticParamData> params;
+    std::vector<StaticString> values;
+    std::string text;
+    // Stored strings sorted by their content, so the repeated ones are found by a binary search
+    std::vector<StaticString> sortedStrings;
+
+    constexpr std::string_view stringView(const StaticString& str) const
+    {
+        return std::string_view{text}.substr(str.offset, str.size);
+    }
+
+    constexpr StaticString addString(std::string_view str)
+    {
+        const auto it = std::lower_bound(
+                sortedStrings.begin(),
+                sortedStrings.end(),
+                str,
+                [this](const StaticString& storedStr, std::string_view value)
+                {
+                    return stringView(storedStr) < value;
+                });
+        if (it != sortedStrings.end() && stringView(*it) == str)
+            return *it;
+
+        const auto result = StaticString{text.size(), str.size()};
+        text += str;
+        sortedStrings.insert(it, result);
+        return result;
+    }
+};
+
+constexpr StaticConfigLayout makeStaticConfigLayout(std::string_view configText)
+{
+    auto builder = StaticConfigBuilder{};
+    auto parser = StaticConfigParser<StaticConfigBuilder>{configText, builder};
+    parser.parse();
+
+    using Node = StaticConfigBuilder::Node;
+    using Param = StaticConfigBuilder::Param;
+    auto layout = StaticConfigLayout{};
+    auto nodeQueue = std::vector<Node*>{&builder.root()};
+    for (auto nodeIndex = std::size_t{}; nodeIndex < nodeQueue.size(); ++nodeIndex) {
+        auto& node = *nodeQueue[nodeIndex];
+        if (!node.isList)
+            std::sort(
+                    node.nodes.begin(),
+                    node.nodes.end(),
+                    [](const Node& lhs, const Node& rhs)
+                    {
+                        return lhs.name < rhs.name;
+                    });
+        std::sort(
+                node.params.begin(),
+                node.params.end(),
+                [](const Param& lhs, const Param& rhs)
+                {
+                    return lhs.name < rhs.name;
+                });
+
+        layout.nodes.push_back(
+                {layout.addString(node.name),
+                 node.position,
+                 node.isList,
+                 layout.params.size(),
+                 node.params.size(),
+                 nodeQueue.size(),
+                 node.nodes.size()});
+        for (const auto& param : node.params) {
+            layout.params.push_back(
+                    {layout.addString(param.name),
+                     param.position,
+                     param.isList,
+                     layout.values.size(),
+                     param.valueList.size()});
+            for (const auto& value : param.valueList)
+                layout.values.push_back(layout.addString(value));
+        }
+        for (auto& childNode : node.nodes)
+            nodeQueue.push_back(&childNode);
+    }
+    return layout;
+}
+
+constexpr StaticConfigSize staticConfigSize(std::string_view configText)
+{
+    const auto layout = makeStaticConfigLayout(configText);
+    return {layout.nodes.size(), layout.params.size(), layout.values.size(), layout.text.size()};
+}
+
+} //namespace detail
+
+/// Param of a StaticConfig, the strings point into the config
+class StaticParam {
+public:
+    constexpr std::string_view name() const
+    {
+        return tables_.string(data().name);
+    }
+
+    constexpr bool isList() const
+    {
+        return data().isList;
+    }
+
+    StreamPosition position() const
+    {
+        return detail::toStreamPosition(data().position);
+    }
+
+    /// Value of a param that isn't a list
+    constexpr std::string_view value() const
+    {
+        assert(!data().isList);
+        return tables_.string(tables_.values[data().firstValue]);
+    }
+
+    /// Number of values of a list param
+    constexpr std::size_t size() const
+    {
+        return data().valueCount;
+    }
+
+    constexpr std::string_view at(std::size_t index) const
+    {
+        assert(index < data().valueCount);
+        return tables_.string(tables_.values[data().firstValue + index]);
+    }
+
+    std::vector<std::string_view> valueList() const
+    {
+        auto result = std::vector<std::string_view>{};
+        for (auto index = std::size_t{}; index < size(); ++index)
+            result.push_back(at(index));
+        return result;
+    }
+
+private:
+    constexpr StaticParam(const detail::StaticConfigTables& tables, std::size_t index)
+        : tables_{tables}
+        , index_{index}
+    {
+    }
+    friend class StaticNode;
+
+    constexpr const detail::StaticParamData& data() const
+    {
+        return tables_.params[index_];
+    }
+
+    detail::StaticConfigTables tables_;
+    std::size_t index_;
+};
+
+/// Node of a StaticConfig with the same shape as figcone::TreeNode. Names of child nodes and params are looked up
+/// with binary search, and all functions except position() can be used in constant expressions.
+class StaticNode {
+public:
+    /// List elements have the name of their list
+    constexpr std::string_view name() const
+    {
+        return tables_.string(data().name);
+    }
+
+    constexpr bool isList() const
+    {
+        return data().isList;
+    }
+
+    StreamPosition position() const
+    {
+        return detail::toStreamPosition(data().position);
+    }
+
+    constexpr std::size_t paramsCount() const
+    {
+        return data().paramCount;
+    }
+
+    constexpr bool hasParam(std::string_view name) const
+    {
+        return findParam(name) != notFound;
+    }
+
+    constexpr StaticParam param(std::string_view name) const
+    {
+        const auto index = findParam(name);
+        if (index == notFound)
+            throw ConfigError{
+                    "Config node '" + std::string{this->name()} + "' doesn't have a param '" + std::string{name} + "'",
+                    position()};
+        return StaticParam{tables_, index};
+    }
+
+    constexpr std::size_t nodesCount() const
+    {
+        return data().isList ? 0 : data().childCount;
+    }
+
+    constexpr bool hasNode(std::string_view name) const
+    {
+        return findNode(name) != notFound;
+    }
+
+    constexpr StaticNode node(std::string_view name) const
+    {
+        const auto index = findNode(name);
+        if (index == notFound)
+            throw ConfigError{
+                    "Config node '" + std::string{this->name()} + "' doesn't have a node '" + std::string{name} + "'",
+                    position()};
+        return StaticNode{tables_, index};
+    }
+
+    /// Number of elements of a list node
+    constexpr std::size_t size() const
+    {
+        return data().isList ? data().childCount : 0;
+    }
+
+    constexpr StaticNode at(std::size_t index) const
+    {
+        assert(data().isList && index < data().childCount);
+        return StaticNode{tables_, data().firstChild + index};
+    }
+
+private:
+    static constexpr auto notFound = static_cast<std::size_t>(-1);
+
+    constexpr StaticNode(const detail::StaticConfigTables& tables, std::size_t index)
+        : tables_{tables}
+        , index_{index}
+    {
+    }
+    template<detail::StaticConfigSize>
+    friend class StaticConfig;
+
+    // Adds the params and child nodes to the figcone::TreeNode
+    void addTo(TreeNode& treeNode) const
+    {
+        for (auto index = data().firstParam; index < data().firstParam + data().paramCount; ++index) {
+            const auto param = StaticParam{tables_, index};
+            if (param.isList()) {
+                auto valueList = std::vector<std::string>{};
+                for (auto valueIndex = std::size_t{}; valueIndex < param.size(); ++valueIndex)
+                    valueList.emplace_back(param.at(valueIndex));
+                treeNode.asItem().addParamList(std::string{param.name()}, valueList, param.position());
+            }
+            else
+                treeNode.asItem().addParam(std::string{param.name()}, std::string{param.value()}, param.position());
+        }
+
+        for (auto index = data().firstChild; index < data().firstChild + data().childCount; ++index) {
+            const auto childNode = StaticNode{tables_, index};
+            if (isList())
+                childNode.addTo(treeNode.asList().emplaceBack(childNode.position()));
+            else if (childNode.isList())
+                childNode.addTo(treeNode.asItem().addNodeList(std::string{childNode.name()}, childNode.position()));
+            else
+                childNode.addTo(treeNode.asItem().addNode(std::string{childNode.name()}, childNode.position()));
+        }
+    }
+
+
+    constexpr const detail::StaticNodeData& data() const
+    {
+        return tables_.nodes[index_];
+    }
+
+    template<typename TNameGetter>
+    static constexpr std::size_t findByName(
+            std::size_t first,
+            std::size_t count,
+            std::string_view name,
+            TNameGetter recordName)
+    {
+        auto begin = first;
+        auto end = first + count;
+        while (begin < end) {
+            const auto middle = begin + (end - begin) / 2;
+            if (recordName(middle) < name)
+                begin = middle + 1;
+            else
+                end = middle;
+        }
+        return begin < first + count && recordName(begin) == name ? begin : notFound;
+    }
+
+    constexpr std::size_t findParam(std::string_view name) const
+    {
+        return findByName(
+                data().firstParam,
+                data().paramCount,
+                name,
+                [this](std::size_t index)
+                {
+                    return tables_.string(tables_.params[index].name);
+                });
+    }
+
+    constexpr std::size_t findNode(std::string_view name) const
+    {
+        if (data().isList)
+            return notFound;
+        return findByName(
+                data().firstChild,
+                data().childCount,
+                name,
+                [this](std::size_t index)
+                {
+                    return tables_.string(tables_.nodes[index].name);
+                });
+    }
+
+    detail::StaticConfigTables tables_;
+    std::size_t index_;
+};
+
+/// Config parsed at compile time by parseStatic(). It's stored in fixed-size arrays without pointers,
+/// so it doesn't allocate and can be placed in the read-only data of the program.
+template<detail::StaticConfigSize Size>
+class StaticConfig {
+public:
+    constexpr explicit StaticConfig(const detail::StaticConfigLayout& layout)
+    {
+        std::copy(layout.nodes.begin(), layout.nodes.end(), nodes_.begin());
+        std::copy(layout.params.begin(), layout.params.end(), params_.begin());
+        std::copy(layout.values.begin(), layout.values.end(), values_.begin());
+        std::copy(layout.text.begin(), layout.text.end(), text_.begin());
+    }
+
+    constexpr StaticNode root() const
+    {
+        return StaticNode{tables(), 0};
+    }
+
+    /// Builds figcone::Tree with the content of the config
+    Tree tree() const
+    {
+        auto treeRoot = makeTreeRoot();
+        root().addTo(*treeRoot);
+        return Tree{std::move(treeRoot)};
+    }
+
+private:
+    constexpr detail::StaticConfigTables tables() const
+    {
+        return {nodes_.data(), params_.data(), values_.data(), text_.data()};
+    }
+
+    std::array<detail::StaticNodeData, Size.nodeCount> nodes_{};
+    std::array<detail::StaticParamData, Size.paramCount> params_{};
+    std::array<detail::StaticString, Size.valueCount> values_{};
+    std::array<char, Size.textSize> text_{};
+};
+
+/// Parses the config at compile time, syntax errors make the compilation fail.
+/// The result is usable in constant expressions when it's stored in a static constexpr variable:
+///     static constexpr auto defaults = figcone::shoal::parseStatic<R"(port = 8080)">();
+///     static_assert(defaults.root().param("port").value() == "8080");
+template<StaticConfigText Text>
+consteval auto parseStatic()
+{
+    constexpr auto size = detail::staticConfigSize(Text.view());
+    return StaticConfig<size>{detail::makeStaticConfigLayout(Text.view())};
+}
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_HAS_STATIC_CONFIG
+
+#endif //FIGCONE_SHOAL_STATICCONFIG_H
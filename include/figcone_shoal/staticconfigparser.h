@@ -0,0 +1,613 @@
+#ifndef FIGCONE_SHOAL_STATICCONFIGPARSER_H
+#define FIGCONE_SHOAL_STATICCONFIGPARSER_H
+
+#include <figcone_tree/errors.h>
+#include <figcone_tree/streamposition.h>
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compile-time counterpart of the parser in src/, it follows the same grammar and must be kept in sync with it.
+// Strings are copied into std::string, as the parsed values can be joined from several parts of the text,
+// and all the memory is released before the end of the constant evaluation.
+namespace figcone::shoal::detail {
+
+struct StaticPosition {
+    int line;
+    int column;
+};
+
+// Parsing errors are reported by calling this non-constexpr function, which makes the constant evaluation fail.
+// The compiler's diagnostic shows the failed call with the error message.
+[[noreturn]] inline void staticConfigError(const char* message, StaticPosition position)
+{
+    throw ConfigError{message, StreamPosition{position.line, position.column}};
+}
+
+constexpr auto staticWhitespaceChars = std::string_view{" \t\n\v\f\r"};
+constexpr auto staticBlankChars = std::string_view{" \t\v\f"};
+
+constexpr bool isStaticSpace(char ch)
+{
+    return ch != '\0' && staticWhitespaceChars.find(ch) != std::string_view::npos;
+}
+
+class StaticStream {
+public:
+    constexpr explicit StaticStream(std::string_view data)
+        : data_{data}
+    {
+    }
+
+    constexpr void skip(int size)
+    {
+        for (auto i = 0; i < size; ++i)
+            readChar();
+    }
+
+    constexpr void skipLineSeparator()
+    {
+        auto ch = char{};
+        if (!readRaw(ch))
+            return;
+        if (ch == '\n')
+            return;
+        else if (ch == '\r') {
+            if (peekRaw(0, ch) && ch == '\n')
+                pos_++;
+        }
+        else
+            pos_--;
+    }
+
+    constexpr void skipComments(bool state)
+    {
+        skipComments_ = state;
+    }
+
+    constexpr char readChar()
+    {
+        auto ch = char{};
+        if (!readRaw(ch))
+            return '\0';
+        if (skipComments_ && ch == ';') {
+            pos_ += findLineEnd(0);
+            if (!readRaw(ch))
+                return '\0';
+        }
+
+        if (ch == '\r') {
+            auto nextCh = char{};
+            if (peekRaw(0, nextCh) && nextCh == '\n')
+                pos_++;
+            ch = '\n';
+        }
+        return ch;
+    }
+
+    constexpr char peekChar() const
+    {
+        auto ch = char{};
+        if (!peekRaw(0, ch))
+            return '\0';
+        if (skipComments_ && ch == ';' && !peekRaw(findLineEnd(1), ch))
+            return '\0';
+        return ch == '\r' ? '\n' : ch;
+    }
+
+    constexpr bool peekMatches(std::string_view str) const
+    {
+        auto ch = char{};
+        auto offset = std::size_t{};
+        for (auto expectedCh : str) {
+            if (!peekRaw(offset++, ch))
+                return false;
+            if (skipComments_ && ch == ';') {
+                offset = findLineEnd(offset);
+                if (!peekRaw(offset++, ch))
+                    return false;
+            }
+            if (ch == '\r') {
+                auto nextCh = char{};
+                if (peekRaw(offset, nextCh) && nextCh == '\n')
+                    offset++;
+                ch = '\n';
+            }
+            if (ch != expectedCh)
+                return false;
+        }
+        return true;
+    }
+
+    constexpr std::string_view readSpan(std::string_view stopChars)
+    {
+        auto size = std::size_t{};
+        for (; pos_ + size < data_.size(); ++size) {
+            const auto ch = data_[pos_ + size];
+            if (stopChars.find(ch) != std::string_view::npos || ch == '\r' || ch == '\n' ||
+                (skipComments_ && ch == ';'))
+                break;
+        }
+        const auto result = data_.substr(pos_, size);
+        pos_ += size;
+        return result;
+    }
+
+    constexpr void skipWhile(std::string_view chars)
+    {
+        while (pos_ < data_.size() && chars.find(data_[pos_]) != std::string_view::npos)
+            pos_++;
+    }
+
+    constexpr bool atEnd() const
+    {
+        auto ch = char{};
+        if (!peekRaw(0, ch))
+            return true;
+        if (skipComments_ && ch == ';')
+            return !peekRaw(findLineEnd(1), ch);
+        return false;
+    }
+
+    constexpr std::size_t offset() const
+    {
+        return pos_;
+    }
+
+    constexpr StaticPosition position() const
+    {
+        return position(pos_);
+    }
+
+    // Same as LineIndex: "\r\n", "\r" and "\n" separate lines, tabs take 4 columns
+    constexpr StaticPosition position(std::size_t offset) const
+    {
+        auto line = 1;
+        auto lineStart = std::size_t{};
+        auto tabCount = 0;
+        for (auto i = std::size_t{}; i < offset; ++i) {
+            const auto ch = data_[i];
+            if (ch == '\t')
+                tabCount++;
+            else if (ch == '\n' && i > 0 && data_[i - 1] == '\r')
+                lineStart = i + 1;
+            else if (ch == '\r' || ch == '\n') {
+                line++;
+                lineStart = i + 1;
+                tabCount = 0;
+            }
+        }
+        return {line, 1 + static_cast<int>(offset - lineStart) + 3 * tabCount};
+    }
+
+private:
+    constexpr bool readRaw(char& ch)
+    {
+        if (!peekRaw(0, ch))
+            return false;
+        pos_++;
+        return true;
+    }
+
+    constexpr bool peekRaw(std::size_t offset, char& ch) const
+    {
+        if (data_.size() - pos_ <= offset)
+            return false;
+        ch = data_[pos_ + offset];
+        return true;
+    }
+
+    constexpr std::size_t findLineEnd(std::size_t offset) const
+    {
+        while (pos_ + offset < data_.size() && data_[pos_ + offset] != '\r' && data_[pos_ + offset] != '\n')
+            offset++;
+        return offset;
+    }
+
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+    bool skipComments_ = true;
+};
+
+constexpr bool isStaticBlank(std::string_view str)
+{
+    return str.find_first_not_of(staticWhitespaceChars) == std::string_view::npos;
+}
+
+constexpr std::string_view staticTrim(std::string_view str)
+{
+    const auto first = str.find_first_not_of(staticWhitespaceChars);
+    if (first == std::string_view::npos)
+        return {};
+    const auto last = str.find_last_not_of(staticWhitespaceChars);
+    return str.substr(first, last - first + 1);
+}
+
+constexpr void skipStaticWhitespace(StaticStream& stream, bool withNewLine = true)
+{
+    while (!stream.atEnd()) {
+        stream.skipWhile(staticBlankChars);
+        const auto nextChar = stream.peekChar();
+        if (!withNewLine && nextChar == '\n')
+            return;
+
+        if (isStaticSpace(nextChar))
+            stream.skip(1);
+        else
+            return;
+    }
+}
+
+constexpr std::string readStaticUntil(StaticStream& stream, std::string_view stopChars = {})
+{
+    auto result = std::string{};
+    while (!stream.atEnd()) {
+        result += stream.readSpan(stopChars);
+        if (stream.atEnd() || stopChars.find(stream.peekChar()) != std::string_view::npos)
+            break;
+        result.push_back(stream.readChar());
+    }
+    return result;
+}
+
+constexpr std::string readStaticWord(StaticStream& stream, std::string_view stopChars = {})
+{
+    auto stopCharSet = std::string{stopChars};
+    stopCharSet += staticWhitespaceChars;
+    return readStaticUntil(stream, stopCharSet);
+}
+
+constexpr std::optional<std::string> readStaticQuotedString(StaticStream& stream)
+{
+    if (stream.atEnd())
+        return {};
+
+    const auto quotationMark = stream.peekChar();
+    if (quotationMark != '\'' && quotationMark != '"' && quotationMark != '`')
+        return {};
+
+    stream.skipComments(false);
+    const auto offset = stream.offset();
+    stream.skip(1);
+
+    if (stream.peekChar() == '\n')
+        stream.skipLineSeparator();
+
+    const auto stopChars = std::string(1, quotationMark);
+    auto result = std::string{};
+    while (!stream.atEnd()) {
+        result += stream.readSpan(stopChars);
+        if (stream.atEnd())
+            break;
+        const auto ch = stream.readChar();
+        if (ch == quotationMark) {
+            stream.skipComments(true);
+            return result;
+        }
+        result.push_back(ch);
+    }
+    staticConfigError("String isn't closed", stream.position(offset));
+}
+
+struct StaticParsedParam {
+    std::string name;
+    std::vector<std::string> valueList;
+    bool isList = false;
+    std::size_t offset = 0;
+};
+
+constexpr void skipStaticParamWhitespace(StaticStream& stream)
+{
+    skipStaticWhitespace(stream, false);
+    if (stream.peekChar() == '\n')
+        staticConfigError(
+                "Wrong param format: parameter's value must be placed on the same line as its name",
+                stream.position());
+}
+
+constexpr std::optional<std::string> readStaticSingleParam(
+        StaticStream& stream,
+        std::string_view stopChars,
+        const std::vector<std::string>& paramListValue,
+        bool isMultiline)
+{
+    if (isMultiline)
+        stream.skipComments(false);
+
+    auto result = readStaticQuotedString(stream);
+    if (!result) {
+        result = std::string{staticTrim(readStaticUntil(stream, stopChars))};
+        if (result->empty()) {
+            if (stream.peekChar() == ',' || (paramListValue.empty() && !isMultiline))
+                staticConfigError("Parameter list element is missing", stream.position());
+            if (paramListValue.empty() && isMultiline)
+                result.reset();
+        }
+    }
+    if (isMultiline)
+        stream.skipComments(true);
+    return result;
+}
+
+constexpr void readStaticParamOrParamList(StaticStream& stream, StaticParsedParam& param, bool isMultiline = false)
+{
+    param.isList = isMultiline;
+    while (!stream.atEnd()) {
+        auto paramValue = readStaticSingleParam(stream, isMultiline ? ",]\n" : ",\n", param.valueList, isMultiline);
+        if (paramValue)
+            param.valueList.push_back(std::move(*paramValue));
+
+        skipStaticWhitespace(stream, isMultiline);
+        const auto endOfList = isMultiline ? ']' : '\n';
+        if (stream.peekChar() == ',') {
+            param.isList = true;
+            stream.skip(1);
+            skipStaticWhitespace(stream, isMultiline);
+            if (stream.peekChar() == endOfList || stream.atEnd())
+                staticConfigError("Parameter list element is missing", stream.position());
+        }
+        else if (stream.peekChar() == endOfList) {
+            stream.skip(1);
+            return;
+        }
+        else if (stream.atEnd())
+            return;
+        else
+            staticConfigError("Wrong param format: there must be only one parameter per line", stream.position());
+    }
+}
+
+constexpr void readStaticParam(StaticStream& stream, StaticParsedParam& param)
+{
+    param = {};
+    skipStaticWhitespace(stream);
+    param.offset = stream.offset();
+    param.name = readStaticWord(stream, "=");
+    if (param.name.empty())
+        staticConfigError("Parameter's name can't be empty", stream.position(param.offset));
+
+    skipStaticParamWhitespace(stream);
+    const auto offset = stream.offset();
+    if (stream.readChar() != '=')
+        staticConfigError("Wrong param format: missing '='", stream.position(offset));
+    skipStaticParamWhitespace(stream);
+
+    skipStaticWhitespace(stream, false);
+    if (stream.peekChar() == '\n' || stream.atEnd())
+        staticConfigError("Parameter's value is missing", stream.position());
+    if (stream.peekChar() == '[') {
+        stream.skip(1);
+        skipStaticWhitespace(stream);
+        readStaticParamOrParamList(stream, param, true);
+    }
+    else
+        readStaticParamOrParamList(stream, param, false);
+}
+
+struct StaticReadResult {
+    enum class NextAction {
+        ContinueReading,
+        ReturnToParentNode,
+        ReturnToNodeByName,
+        ReturnToRootNode
+    } nextAction;
+    std::string parentNodeName;
+    std::optional<std::size_t> returnToNodeOffset;
+};
+
+struct StaticOpenNode {
+    bool isRoot;
+    bool isList;
+    std::vector<std::string> childNodeNames;
+};
+
+// Receives the parsing events, THandler has the same functions as IEventHandler
+template<typename THandler>
+class StaticConfigParser {
+    using NextAction = StaticReadResult::NextAction;
+
+public:
+    constexpr StaticConfigParser(std::string_view data, THandler& handler)
+        : stream_{data}
+        , handler_{handler}
+    {
+    }
+
+    constexpr void parse()
+    {
+        auto rootNode = StaticOpenNode{true, false, {}};
+        parseNode(rootNode, "");
+    }
+
+private:
+    constexpr std::string readNodeName()
+    {
+        stream_.skip(1);
+        auto nodeName = readStaticUntil(stream_, "\n:");
+        if (stream_.peekChar() == '\n')
+            staticConfigError("Config node can't have a multiline name", stream_.position());
+
+        if (stream_.peekChar() == ':') {
+            stream_.skip(1);
+            const auto offset = stream_.offset();
+            if (!isStaticBlank(readStaticUntil(stream_, "\n")))
+                staticConfigError(
+                        "Wrong config node format: only whitespaces and comments can be placed on the same line with "
+                        "config node's name.",
+                        stream_.position(offset));
+        }
+        return nodeName;
+    }
+
+    constexpr StaticReadResult readEndToken()
+    {
+        stream_.skip(1);
+        if (stream_.atEnd() || isStaticSpace(stream_.peekChar()))
+            return {NextAction::ReturnToParentNode, {}, {}};
+
+        if (stream_.peekMatches("--")) {
+            stream_.skip(2);
+            if (!stream_.atEnd() && !isStaticSpace(stream_.peekChar()))
+                staticConfigError("Invalid closing token", stream_.position());
+            return {NextAction::ReturnToRootNode, {}, {}};
+        }
+
+        const auto offset = stream_.offset();
+        if (stream_.readChar() != '-')
+            staticConfigError("Invalid closing token", stream_.position(offset));
+        return {NextAction::ReturnToNodeByName, readStaticWord(stream_), offset};
+    }
+
+    constexpr StaticReadResult checkReadResult(
+            const StaticReadResult& readResult,
+            std::string_view newNodeName,
+            const StaticOpenNode& parentNode)
+    {
+        // The conditional operator isn't used here, as GCC 12 fails to evaluate it at compile time
+        // when it copies std::string members
+        if (readResult.nextAction == NextAction::ReturnToRootNode) {
+            if (parentNode.isRoot)
+                return {NextAction::ContinueReading, {}, {}};
+            return readResult;
+        }
+
+        const auto returnToNodePosition = [&]
+        {
+            return readResult.returnToNodeOffset ? stream_.position(*readResult.returnToNodeOffset)
+                                                 : StaticPosition{};
+        };
+
+        if (readResult.nextAction == NextAction::ReturnToParentNode && parentNode.isList) {
+            if (parentNode.isRoot)
+                staticConfigError("Can't close root node", returnToNodePosition());
+            else
+                return readResult;
+        }
+
+        if (readResult.nextAction == NextAction::ReturnToNodeByName) {
+            if (newNodeName != readResult.parentNodeName) {
+                if (parentNode.isRoot)
+                    staticConfigError("Can't close unexisting node", returnToNodePosition());
+                else
+                    return readResult;
+            }
+            else if (parentNode.isList)
+                return {NextAction::ReturnToParentNode, {}, {}};
+        }
+        return {NextAction::ContinueReading, {}, {}};
+    }
+
+    constexpr std::optional<StaticReadResult> checkNodeSectionResult(
+            const StaticReadResult& readResult,
+            std::string_view nodeName,
+            const StaticOpenNode& parentNode)
+    {
+        auto result = checkReadResult(readResult, nodeName, parentNode);
+        if (result.nextAction != NextAction::ContinueReading) {
+            if (result.nextAction == NextAction::ReturnToParentNode)
+                result.nextAction = NextAction::ContinueReading;
+            return result;
+        }
+        return {};
+    }
+
+    constexpr std::optional<StaticReadResult> readListElementSeparator()
+    {
+        stream_.skip(3);
+        skipStaticWhitespace(stream_, false);
+        if (stream_.atEnd())
+            return StaticReadResult{NextAction::ReturnToRootNode, {}, {}};
+
+        if (stream_.peekChar() != '\n')
+            staticConfigError(
+                    "Wrong config node list format: there can't be anything besides comments and whitespaces on the "
+                    "same line with list separator '###'",
+                    stream_.position());
+
+        skipStaticWhitespace(stream_, true);
+        if (stream_.atEnd())
+            return StaticReadResult{NextAction::ReturnToRootNode, {}, {}};
+        else if (stream_.peekChar() == '-')
+            return readEndToken();
+        return {};
+    }
+
+    constexpr std::optional<StaticReadResult> parseListElementNodeSection(
+            StaticOpenNode& parent,
+            std::string_view parentName)
+    {
+        if (!parent.isList)
+            return StaticReadResult{NextAction::ContinueReading, {}, {}};
+
+        auto readResult = readListElementSeparator();
+        if (!readResult) {
+            handler_.onListElement(stream_.position());
+            auto newNode = StaticOpenNode{false, false, {}};
+            readResult = parseNode(newNode, parentName);
+            handler_.onNodeEnd();
+        }
+        return checkNodeSectionResult(*readResult, parentName, parent);
+    }
+
+    constexpr std::optional<StaticReadResult> parseNodeSection(StaticOpenNode& parent)
+    {
+        const auto offset = stream_.offset();
+        const auto name = readNodeName();
+        if (isStaticBlank(name))
+            staticConfigError("Config node name can't be blank", stream_.position(offset));
+        skipStaticWhitespace(stream_);
+
+        if (std::find(parent.childNodeNames.begin(), parent.childNodeNames.end(), name) !=
+            parent.childNodeNames.end())
+            staticConfigError("Config node already exist", stream_.position(offset));
+        parent.childNodeNames.push_back(name);
+
+        const auto isList = stream_.peekMatches("###");
+        if (isList)
+            handler_.onNodeListBegin(name, stream_.position(offset));
+        else
+            handler_.onNodeBegin(name, stream_.position(offset));
+
+        auto newNode = StaticOpenNode{false, isList, {}};
+        const auto readResult = parseNode(newNode, name);
+        handler_.onNodeEnd();
+        return checkNodeSectionResult(readResult, name, parent);
+    }
+
+    constexpr StaticReadResult parseNode(StaticOpenNode& node, std::string_view nodeName)
+    {
+        while (!stream_.atEnd()) {
+            const auto nextChar = stream_.peekChar();
+            if (isStaticSpace(nextChar))
+                stream_.skip(1);
+            else if (stream_.peekMatches("###")) {
+                if (auto result = parseListElementNodeSection(node, nodeName))
+                    return *result;
+            }
+            else if (nextChar == '#') {
+                if (auto result = parseNodeSection(node))
+                    return *result;
+            }
+            else if (nextChar == '-')
+                return readEndToken();
+            else {
+                readStaticParam(stream_, param_);
+                handler_.onParam(param_, stream_.position(param_.offset));
+            }
+        }
+        return {NextAction::ReturnToRootNode, {}, {}};
+    }
+
+private:
+    StaticStream stream_;
+    THandler& handler_;
+    StaticParsedParam param_;
+};
+
+} //namespace figcone::shoal::detail
+
+#endif //FIGCONE_SHOAL_STATICCONFIGPARSER_H
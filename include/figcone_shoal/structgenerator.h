@@ -0,0 +1,19 @@
+#ifndef FIGCONE_SHOAL_STRUCTGENERATOR_H
+#define FIGCONE_SHOAL_STRUCTGENERATOR_H
+
+#include <string>
+#include <string_view>
+
+namespace figcone::shoal {
+
+/// Generates a C++ header with a reader that parses shoal configs straight into the structs described by the schema,
+/// without building figcone::Tree. The schema is a shoal config: every top-level node describes a struct,
+/// its params are the fields with their types, e.g. `port = int`, `hosts = list<string>` or `tls = optional<Tls>`.
+/// Top-level params set the `root` struct, the `namespace` of the generated code and the `include` files declaring
+/// the structs; without `include` the structs are declared by the generated header.
+/// The config keys of every struct are matched by a switch over their perfect hash, see structKeyHash().
+std::string generateStructReader(std::string_view schema);
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_STRUCTGENERATOR_H
@@ -0,0 +1,225 @@
+#ifndef FIGCONE_SHOAL_STRUCTREADER_H
+#define FIGCONE_SHOAL_STRUCTREADER_H
+
+#include "ieventhandler.h"
+#include "parser.h"
+#include <figcone_tree/errors.h>
+#include <figcone_tree/stringconverter.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace figcone::shoal {
+
+/// Hash of the config keys used by the readers generated with generateStructReader().
+/// The generator picks the seed that maps the field names of every struct to distinct slots.
+constexpr std::uint32_t structKeyHash(std::string_view key, std::uint32_t seed)
+{
+    auto hash = 2166136261u ^ seed;
+    for (auto ch : key) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+/// Base class of the readers generated with generateStructReader(), it keeps the stack of the structs being filled
+/// and converts the param values into the field types.
+class StructReaderBase : public IEventHandler {
+protected:
+    struct Frame {
+        int type;
+        void* object;
+        std::uint64_t readFields;
+        StreamPosition position;
+    };
+
+    Frame& currentFrame()
+    {
+        return frames_.back();
+    }
+
+    Frame popFrame()
+    {
+        auto frame = frames_.back();
+        frames_.pop_back();
+        return frame;
+    }
+
+    void beginFrame(int type, void* object, const StreamPosition& position)
+    {
+        frames_.push_back(Frame{type, object, 0, position});
+    }
+
+    template<typename TField>
+    void beginNode(
+            int type,
+            TField& field,
+            std::uint64_t& readFields,
+            std::uint64_t fieldBit,
+            std::string_view name,
+            bool isList,
+            const StreamPosition& position)
+    {
+        if (isList)
+            throw ConfigError{"Config node '" + std::string{name} + "' can't be a node list", position};
+        readFields |= fieldBit;
+        beginFrame(type, &resetField(field), position);
+    }
+
+    template<typename TField>
+    void beginNodeList(
+            int type,
+            TField& field,
+            std::uint64_t& readFields,
+            std::uint64_t fieldBit,
+            std::string_view name,
+            bool isList,
+            const StreamPosition& position)
+    {
+        if (!isList)
+            throw ConfigError{"Config node '" + std::string{name} + "' must be a node list", position};
+        readFields |= fieldBit;
+        beginFrame(type, &resetField(field), position);
+    }
+
+    template<typename T>
+    void beginListElement(int type, const StreamPosition& position)
+    {
+        auto& list = *static_cast<std::vector<T>*>(currentFrame().object);
+        beginFrame(type, &list.emplace_back(), position);
+    }
+
+    /// Like figcone::Tree, keeps the first value of a repeated param
+    template<typename TField, typename TValue>
+    static void readField(
+            TField& field,
+            std::uint64_t& readFields,
+            std::uint64_t fieldBit,
+            std::string_view name,
+            const TValue& value,
+            const ParamPosition& position)
+    {
+        if (readFields & fieldBit)
+            return;
+        readFields |= fieldBit;
+        assignParam(field, name, value, position);
+    }
+
+    [[noreturn]] static void throwUnknownParam(std::string_view name, const ParamPosition& position)
+    {
+        throw ConfigError{"Unknown parameter '" + std::string{name} + "'", position.resolve()};
+    }
+
+    [[noreturn]] static void throwUnknownNode(std::string_view name, const StreamPosition& position)
+    {
+        throw ConfigError{"Unknown config node '" + std::string{name} + "'", position};
+    }
+
+    [[noreturn]] static void throwMissingParam(std::string_view name, const StreamPosition& position)
+    {
+        throw ConfigError{"Parameter '" + std::string{name} + "' is missing", position};
+    }
+
+    [[noreturn]] static void throwMissingNode(std::string_view name, const StreamPosition& position)
+    {
+        throw ConfigError{"Config node '" + std::string{name} + "' is missing", position};
+    }
+
+private:
+    template<typename T>
+    static T& resetField(T& field)
+    {
+        field = T{};
+        return field;
+    }
+
+    template<typename T>
+    static T& resetField(std::optional<T>& field)
+    {
+        return field.emplace();
+    }
+
+    template<typename T>
+    static T convertParam(std::string_view name, std::string_view value, const ParamPosition& position)
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string{value};
+        else {
+            auto result = StringConverter<T>::fromString(std::string{value});
+            if (!result)
+                throw ConfigError{
+                        "Couldn't set parameter '" + std::string{name} + "' value from '" + std::string{value} + "'",
+                        position.resolve()};
+            return *result;
+        }
+    }
+
+    template<typename T>
+    static void assignParam(T& field, std::string_view name, std::string_view value, const ParamPosition& position)
+    {
+        field = convertParam<T>(name, value, position);
+    }
+
+    template<typename T>
+    static void assignParam(
+            std::vector<T>&,
+            std::string_view name,
+            std::string_view,
+            const ParamPosition& position)
+    {
+        throw ConfigError{"Parameter '" + std::string{name} + "' must be a list", position.resolve()};
+    }
+
+    template<typename T>
+    static void assignParam(
+            T&,
+            std::string_view name,
+            const std::vector<std::string_view>&,
+            const ParamPosition& position)
+    {
+        throw ConfigError{"Parameter '" + std::string{name} + "' can't be a list", position.resolve()};
+    }
+
+    template<typename T>
+    static void assignParam(
+            std::vector<T>& field,
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position)
+    {
+        field.clear();
+        for (auto value : valueList)
+            field.push_back(convertParam<T>(name, value, position));
+    }
+
+    template<typename T>
+    static void assignParam(
+            std::optional<T>& field,
+            std::string_view name,
+            std::string_view value,
+            const ParamPosition& position)
+    {
+        assignParam(field.emplace(), name, value, position);
+    }
+
+    template<typename T>
+    static void assignParam(
+            std::optional<T>& field,
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position)
+    {
+        assignParam(field.emplace(), name, valueList, position);
+    }
+
+private:
+    std::vector<Frame> frames_;
+};
+
+} //namespace figcone::shoal
+
+#endif //FIGCONE_SHOAL_STRUCTREADER_H
@@ -0,0 +1,109 @@
+#include "arena.h"
+#include <gsl/assert>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace figcone::shoal::detail {
+
+namespace {
+constexpr auto maxBlockSize = std::size_t{64 * 1024};
+
+char* alignUp(char* ptr, std::size_t alignment)
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    return ptr + ((alignment - address % alignment) % alignment);
+}
+} //namespace
+
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    Expects(alignment <= alignof(std::max_align_t));
+    auto data = alignUp(top_, alignment);
+    // The aligned pointer can be past the end of a block filled up to an unaligned size
+    if (!top_ || data > blockEnd_ || static_cast<std::size_t>(blockEnd_ - data) < size) {
+        addBlock(size);
+        data = top_;
+    }
+    top_ = data + size;
+    return data;
+}
+
+char* Arena::resize(char* data, std::size_t size, std::size_t newSize)
+{
+    if (data && data + size == top_ && static_cast<std::size_t>(blockEnd_ - data) >= newSize) {
+        top_ = data + newSize;
+        return data;
+    }
+    if (newSize <= size)
+        return data;
+
+    auto newData = static_cast<char*>(allocate(newSize, 1));
+    if (size)
+        std::memcpy(newData, data, size);
+    return newData;
+}
+
+bool Arena::release(const char* data, std::size_t size)
+{
+    if (!data || data + size != top_)
+        return false;
+    top_ = const_cast<char*>(data);
+    return true;
+}
+
+std::size_t Arena::allocatedSize() const
+{
+    return allocatedSize_;
+}
+
+void Arena::addBlock(std::size_t minSize)
+{
+    const auto blockSize = std::max(nextBlockSize_, minSize);
+    blocks_.emplace_back(new char[blockSize]);
+    top_ = blocks_.back().get();
+    blockEnd_ = top_ + blockSize;
+    allocatedSize_ += blockSize;
+    nextBlockSize_ = std::min(nextBlockSize_ * 2, maxBlockSize);
+}
+
+ArenaStringBuilder::ArenaStringBuilder(Arena& arena)
+    : arena_{arena}
+{
+}
+
+void ArenaStringBuilder::append(std::string_view str)
+{
+    if (str.empty())
+        return;
+    reserve(size_ + str.size());
+    std::memcpy(data_ + size_, str.data(), str.size());
+    size_ += str.size();
+}
+
+void ArenaStringBuilder::push_back(char ch)
+{
+    reserve(size_ + 1);
+    data_[size_++] = ch;
+}
+
+std::string_view ArenaStringBuilder::release()
+{
+    const auto result = std::string_view{data_, size_};
+    arena_.resize(data_, capacity_, size_);
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    return result;
+}
+
+void ArenaStringBuilder::reserve(std::size_t size)
+{
+    if (size <= capacity_)
+        return;
+    const auto newCapacity = std::max({size, capacity_ * 2, std::size_t{32}});
+    data_ = arena_.resize(data_, capacity_, newCapacity);
+    capacity_ = newCapacity;
+}
+
+} //namespace figcone::shoal::detail
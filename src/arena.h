@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+// Bump-pointer allocator for the transient data of a single parse invocation.
+// Nothing is freed separately, all blocks are released together with the arena.
+class Arena {
+public:
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+    // Resizes the allocation in place if it's the last one in the current block, otherwise moves it.
+    char* resize(char* data, std::size_t size, std::size_t newSize);
+    // Frees the allocation if it's the last one in the current block
+    bool release(const char* data, std::size_t size);
+    std::size_t allocatedSize() const;
+
+private:
+    void addBlock(std::size_t minSize);
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* top_ = nullptr;
+    char* blockEnd_ = nullptr;
+    std::size_t nextBlockSize_ = 4096;
+    std::size_t allocatedSize_ = 0;
+};
+
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena)
+        : arena_{&arena}
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : arena_{other.arena_}
+    {
+    }
+
+    T* allocate(std::size_t size)
+    {
+        return static_cast<T*>(arena_->allocate(size * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t)
+    {
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return arena_ != other.arena_;
+    }
+
+private:
+    template<typename U>
+    friend class ArenaAllocator;
+    Arena* arena_;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// Builds a string at the top of the arena, so appending usually grows it in place.
+// The resulting view stays valid until the arena is destroyed.
+class ArenaStringBuilder {
+public:
+    explicit ArenaStringBuilder(Arena& arena);
+    void append(std::string_view str);
+    void push_back(char ch);
+    std::string_view release();
+
+private:
+    void reserve(std::size_t size);
+
+private:
+    Arena& arena_;
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,222 @@
+#include "charscan.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define FIGCONE_SHOAL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FIGCONE_SHOAL_TARGET_AVX2
+#else
+#define FIGCONE_SHOAL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+template<bool isNegated>
+const char* findScalar(const char* first, const char* last, const CharSet& chars)
+{
+    for (; first != last; ++first)
+        if (chars.contains(*first) != isNegated)
+            return first;
+    return last;
+}
+
+void markScalar(const char* first, const char* last, const CharSet& chars, std::uint64_t* masks)
+{
+    for (auto it = first; it != last; ++it)
+        if (chars.contains(*it)) {
+            const auto offset = static_cast<std::size_t>(it - first);
+            masks[offset / 64] |= std::uint64_t{1} << (offset % 64);
+        }
+}
+
+#ifdef FIGCONE_SHOAL_X86
+
+int countTrailingZeros(std::uint32_t mask)
+{
+#ifdef _MSC_VER
+    auto index = 0ul;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+bool hasAvx2()
+{
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    const auto hasOsXsave = (info[2] & (1 << 27)) != 0;
+    const auto hasAvx = (info[2] & (1 << 28)) != 0;
+    if (!hasOsXsave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+template<bool isNegated>
+const char* findSse2(const char* first, const char* last, const CharSet& chars)
+{
+    constexpr auto blockSize = std::ptrdiff_t{16};
+    const auto charList = chars.chars();
+    __m128i needles[CharSet::maxVectorizedSize];
+    for (auto i = std::size_t{}; i < charList.size(); ++i)
+        needles[i] = _mm_set1_epi8(charList[i]);
+
+    for (; last - first >= blockSize; first += blockSize) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        auto matches = _mm_setzero_si128();
+        for (auto i = std::size_t{}; i < charList.size(); ++i)
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+        if (isNegated)
+            mask = ~mask & 0xFFFFu;
+        if (mask)
+            return first + countTrailingZeros(mask);
+    }
+    return findScalar<isNegated>(first, last, chars);
+}
+
+void markSse2(const char* first, const char* last, const CharSet& chars, std::uint64_t* masks)
+{
+    constexpr auto blockSize = std::ptrdiff_t{64};
+    const auto charList = chars.chars();
+    __m128i needles[CharSet::maxVectorizedSize];
+    for (auto i = std::size_t{}; i < charList.size(); ++i)
+        needles[i] = _mm_set1_epi8(charList[i]);
+
+    auto block = first;
+    for (; last - block >= blockSize; block += blockSize, ++masks) {
+        auto mask = std::uint64_t{};
+        for (auto part = 0; part < 4; ++part) {
+            const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + part * 16));
+            auto matches = _mm_setzero_si128();
+            for (auto i = std::size_t{}; i < charList.size(); ++i)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(data, needles[i]));
+            mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(matches))) << (part * 16);
+        }
+        *masks = mask;
+    }
+    markScalar(block, last, chars, masks);
+}
+
+template<bool isNegated>
+FIGCONE_SHOAL_TARGET_AVX2 const char* findAvx2(const char* first, const char* last, const CharSet& chars)
+{
+    constexpr auto blockSize = std::ptrdiff_t{32};
+    const auto charList = chars.chars();
+    __m256i needles[CharSet::maxVectorizedSize];
+    for (auto i = std::size_t{}; i < charList.size(); ++i)
+        needles[i] = _mm256_set1_epi8(charList[i]);
+
+    for (; last - first >= blockSize; first += blockSize) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        auto matches = _mm256_setzero_si256();
+        for (auto i = std::size_t{}; i < charList.size(); ++i)
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+        if (isNegated)
+            mask = ~mask;
+        if (mask)
+            return first + countTrailingZeros(mask);
+    }
+    return findSse2<isNegated>(first, last, chars);
+}
+
+FIGCONE_SHOAL_TARGET_AVX2 void markAvx2(const char* first, const char* last, const CharSet& chars, std::uint64_t* masks)
+{
+    constexpr auto blockSize = std::ptrdiff_t{64};
+    const auto charList = chars.chars();
+    __m256i needles[CharSet::maxVectorizedSize];
+    for (auto i = std::size_t{}; i < charList.size(); ++i)
+        needles[i] = _mm256_set1_epi8(charList[i]);
+
+    auto block = first;
+    for (; last - block >= blockSize; block += blockSize, ++masks) {
+        const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        const auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        auto lowMatches = _mm256_setzero_si256();
+        auto highMatches = _mm256_setzero_si256();
+        for (auto i = std::size_t{}; i < charList.size(); ++i) {
+            lowMatches = _mm256_or_si256(lowMatches, _mm256_cmpeq_epi8(low, needles[i]));
+            highMatches = _mm256_or_si256(highMatches, _mm256_cmpeq_epi8(high, needles[i]));
+        }
+        *masks = static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(lowMatches))) |
+                (static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(highMatches))) << 32);
+    }
+    markScalar(block, last, chars, masks);
+}
+
+#endif
+
+using FindFunction = const char* (*)(const char*, const char*, const CharSet&);
+
+template<bool isNegated>
+FindFunction selectFindFunction()
+{
+#ifdef FIGCONE_SHOAL_X86
+    if (hasAvx2())
+        return &findAvx2<isNegated>;
+    return &findSse2<isNegated>;
+#else
+    return &findScalar<isNegated>;
+#endif
+}
+
+template<bool isNegated>
+const char* find(const char* first, const char* last, const CharSet& chars)
+{
+    static const auto findFunction = selectFindFunction<isNegated>();
+    if (!chars.isVectorizable())
+        return findScalar<isNegated>(first, last, chars);
+    return findFunction(first, last, chars);
+}
+
+using MarkFunction = void (*)(const char*, const char*, const CharSet&, std::uint64_t*);
+
+MarkFunction selectMarkFunction()
+{
+#ifdef FIGCONE_SHOAL_X86
+    if (hasAvx2())
+        return &markAvx2;
+    return &markSse2;
+#else
+    return &markScalar;
+#endif
+}
+
+} //namespace
+
+const char* findFirstOf(const char* first, const char* last, const CharSet& chars)
+{
+    return find<false>(first, last, chars);
+}
+
+const char* findFirstNotOf(const char* first, const char* last, const CharSet& chars)
+{
+    return find<true>(first, last, chars);
+}
+
+void markCharsOf(const char* first, const char* last, const CharSet& chars, std::uint64_t* masks)
+{
+    static const auto markFunction = selectMarkFunction();
+    if (chars.isVectorizable())
+        markFunction(first, last, chars, masks);
+    else
+        markScalar(first, last, chars, masks);
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,16 @@
+#pragma once
+#include "charset.h"
+#include <cstdint>
+
+namespace figcone::shoal::detail {
+
+// Scanning kernels processing the input in 16 (SSE2) or 32 (AVX2) byte blocks.
+// The implementation is selected at runtime depending on CPU support, with a scalar fallback
+// for other architectures and for character sets too large to be vectorized.
+const char* findFirstOf(const char* first, const char* last, const CharSet& chars);
+const char* findFirstNotOf(const char* first, const char* last, const CharSet& chars);
+// Sets the bits of the characters from chars in the masks of the 64 byte blocks of the input.
+// The masks must be zeroed and there must be one for every started block.
+void markCharsOf(const char* first, const char* last, const CharSet& chars, std::uint64_t* masks);
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace figcone::shoal::detail {
+
+class CharSet {
+public:
+    static constexpr auto maxVectorizedSize = 16;
+
+    constexpr explicit CharSet(std::string_view chars = {})
+    {
+        add(chars);
+    }
+
+    constexpr void add(std::string_view chars)
+    {
+        for (auto ch : chars)
+            add(ch);
+    }
+
+    constexpr void add(char ch)
+    {
+        if (contains(ch))
+            return;
+        const auto index = static_cast<unsigned char>(ch);
+        bits_[index / 64] |= std::uint64_t{1} << (index % 64);
+        if (size_ < maxVectorizedSize)
+            chars_[static_cast<std::size_t>(size_)] = ch;
+        size_++;
+    }
+
+    constexpr bool contains(char ch) const
+    {
+        const auto index = static_cast<unsigned char>(ch);
+        return (bits_[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Character list used by the vectorized scanning kernels, available only for small sets
+    constexpr bool isVectorizable() const
+    {
+        return size_ <= maxVectorizedSize;
+    }
+
+    constexpr std::string_view chars() const
+    {
+        return {chars_.data(), static_cast<std::size_t>(size_)};
+    }
+
+private:
+    std::array<std::uint64_t, 4> bits_ = {};
+    std::array<char, maxVectorizedSize> chars_ = {};
+    int size_ = 0;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,109 @@
+#include "chunkparamreader.h"
+#include "stream.h"
+#include "structuralindex.h"
+#include "utils.h"
+#include "workstealingpool.h"
+#include <algorithm>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+// Chunks preferably start at node sections, which are less likely to be inside a multiline string or list
+std::size_t findChunkBegin(std::string_view data, std::size_t offset)
+{
+    constexpr auto maxNodeSearchSize = std::size_t{4096};
+    auto lineBegin = data.find('\n', offset);
+    if (lineBegin == std::string_view::npos)
+        return data.size();
+    lineBegin++;
+
+    for (auto pos = lineBegin; pos < data.size() && pos - lineBegin < maxNodeSearchSize;) {
+        if (data[pos] == '#')
+            return pos;
+        pos = data.find('\n', pos);
+        if (pos == std::string_view::npos)
+            break;
+        pos++;
+    }
+    return lineBegin;
+}
+
+} //namespace
+
+ChunkParamReader::ChunkParamReader(std::string_view data, const StructuralIndex& index, WorkStealingPool& pool)
+{
+    const auto chunkSize = std::max(data.size() / pool.threadCount(), minChunkSize);
+    for (auto begin = std::size_t{}; begin < data.size();) {
+        const auto end = begin + chunkSize < data.size() ? findChunkBegin(data, begin + chunkSize) : data.size();
+        auto stream = std::make_unique<Stream>(data);
+        stream->setStructuralIndex(index);
+        // The params failed to be read are left to the sequential parsing, which reports the errors
+        stream->disablePositions();
+        stream->skipTo(begin);
+        chunks_.push_back({begin, end, std::move(stream), {}, {}});
+        begin = end;
+    }
+
+    pool.run(
+            chunks_.size(),
+            [this](std::size_t, std::size_t chunkIndex)
+            {
+                readChunk(chunks_[chunkIndex]);
+            });
+}
+
+ChunkParamReader::~ChunkParamReader() = default;
+
+void ChunkParamReader::readChunk(Chunk& chunk)
+{
+    auto& stream = *chunk.stream;
+    auto param = ParamData{};
+    while (true) {
+        skipWhitespace(stream);
+        if (stream.atEnd() || stream.offset() >= chunk.end)
+            return;
+
+        const auto nextChar = stream.peekChar();
+        if (nextChar == '#' || nextChar == '-') {
+            skipLine(stream);
+            continue;
+        }
+
+        const auto offset = stream.offset();
+        if (!readParam(stream, param)) {
+            skipLine(stream);
+            continue;
+        }
+        chunk.params.push_back(
+                {offset, stream.offset(), param.name, param.isList, chunk.values.size(), param.valueList.size()});
+        chunk.values.insert(chunk.values.end(), param.valueList.begin(), param.valueList.end());
+    }
+}
+
+bool ChunkParamReader::read(Stream& stream, ParamData& param)
+{
+    const auto offset = stream.offset();
+    while (chunkIndex_ < chunks_.size() && chunks_[chunkIndex_].end <= offset)
+        chunkIndex_++;
+    if (chunkIndex_ == chunks_.size())
+        return false;
+
+    auto& chunk = chunks_[chunkIndex_];
+    while (chunk.nextParamIndex < chunk.params.size() && chunk.params[chunk.nextParamIndex].offset < offset)
+        chunk.nextParamIndex++;
+    if (chunk.nextParamIndex == chunk.params.size() || chunk.params[chunk.nextParamIndex].offset != offset)
+        return false;
+
+    const auto& chunkParam = chunk.params[chunk.nextParamIndex++];
+    param.offset = offset;
+    param.name = stream.intern(chunkParam.name);
+    param.isList = chunkParam.isList;
+    param.valueList.clear();
+    for (auto i = chunkParam.valueIndex; i < chunkParam.valueIndex + chunkParam.valueCount; ++i)
+        param.valueList.push_back(stream.intern(chunk.values[i]));
+    stream.skipTo(chunkParam.endOffset);
+    return true;
+}
+
+} //namespace figcone::shoal::detail
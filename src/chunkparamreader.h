@@ -0,0 +1,59 @@
+#pragma once
+#include "paramparser.h"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+class Stream;
+class StructuralIndex;
+class WorkStealingPool;
+
+// Reads the params of the in-memory input in chunks on the threads of the pool, before the sequential parsing.
+// A chunk starts at a line beginning and speculatively assumes that it isn't inside a multiline string or list.
+// The result of readParam depends only on the input from the param's offset, so a param read by a chunk
+// is used only when the sequential parsing reaches the same offset. Misplaced params of wrongly speculated
+// chunks are never reached, and the params failed to be read are left to the sequential parsing,
+// which reports the errors.
+class ChunkParamReader {
+    struct ChunkParam {
+        std::size_t offset;
+        std::size_t endOffset;
+        std::string_view name;
+        bool isList;
+        std::size_t valueIndex;
+        std::size_t valueCount;
+    };
+
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+        std::unique_ptr<Stream> stream;
+        std::vector<ChunkParam> params;
+        std::vector<std::string_view> values;
+        std::size_t nextParamIndex = 0;
+    };
+
+public:
+    static constexpr auto minChunkSize = std::size_t{256 * 1024};
+
+    // The input is split into a chunk per thread of the pool
+    ChunkParamReader(std::string_view data, const StructuralIndex& index, WorkStealingPool& pool);
+    ~ChunkParamReader();
+    ChunkParamReader(const ChunkParamReader&) = delete;
+    ChunkParamReader& operator=(const ChunkParamReader&) = delete;
+
+    // Reads the param at the current stream offset if it was read by a chunk.
+    // The params must be requested in the order of their offsets.
+    bool read(Stream& stream, ParamData& param);
+
+private:
+    static void readChunk(Chunk& chunk);
+
+private:
+    std::vector<Chunk> chunks_;
+    std::size_t chunkIndex_ = 0;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,227 @@
+#include "compiledimage.h"
+#include "mappedfile.h"
+#include "treebuilder.h"
+#include <figcone_shoal/compiledconfig.h>
+#include <figcone_tree/errors.h>
+#include <gsl/assert>
+
+namespace figcone::shoal {
+
+namespace {
+
+constexpr auto notFound = std::uint32_t{0xffffffff};
+
+template<typename TRecordGetter>
+std::uint32_t findByName(std::uint32_t first, std::uint32_t count, std::string_view name, TRecordGetter recordName)
+{
+    auto begin = first;
+    auto end = first + count;
+    while (begin < end) {
+        const auto middle = begin + (end - begin) / 2;
+        if (recordName(middle) < name)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return begin < first + count && recordName(begin) == name ? begin : notFound;
+}
+
+void buildTree(
+        const detail::CompiledImage& image,
+        const detail::CompiledNodeRecord& node,
+        detail::TreeBuilder& treeBuilder)
+{
+    for (auto index = node.firstParam; index < node.firstParam + node.paramCount; ++index) {
+        const auto param = image.param(index);
+        if (param.isList) {
+            auto valueList = std::vector<std::string_view>{};
+            for (auto valueIndex = param.firstValue; valueIndex < param.firstValue + param.valueCount; ++valueIndex)
+                valueList.push_back(image.value(valueIndex));
+            treeBuilder.onParamList(image.string(param.name), valueList, detail::toStreamPosition(param.position));
+        }
+        else
+            treeBuilder.onParam(
+                    image.string(param.name),
+                    image.value(param.firstValue),
+                    detail::toStreamPosition(param.position));
+    }
+
+    for (auto index = node.firstChild; index < node.firstChild + node.childCount; ++index) {
+        const auto childNode = image.node(index);
+        if (node.isList)
+            treeBuilder.onListElement(detail::toStreamPosition(childNode.position));
+        else if (childNode.isList)
+            treeBuilder.onNodeListBegin(image.string(childNode.name), detail::toStreamPosition(childNode.position));
+        else
+            treeBuilder.onNodeBegin(image.string(childNode.name), detail::toStreamPosition(childNode.position));
+        buildTree(image, childNode, treeBuilder);
+        treeBuilder.onNodeEnd();
+    }
+}
+
+} //namespace
+
+CompiledParam::CompiledParam(const detail::CompiledImage& image, std::uint32_t index)
+    : image_{&image}
+    , index_{index}
+{
+}
+
+std::string_view CompiledParam::name() const
+{
+    return image_->string(image_->param(index_).name);
+}
+
+bool CompiledParam::isList() const
+{
+    return image_->param(index_).isList;
+}
+
+StreamPosition CompiledParam::position() const
+{
+    return detail::toStreamPosition(image_->param(index_).position);
+}
+
+std::string_view CompiledParam::value() const
+{
+    const auto param = image_->param(index_);
+    Expects(!param.isList);
+    return image_->value(param.firstValue);
+}
+
+std::vector<std::string_view> CompiledParam::valueList() const
+{
+    const auto param = image_->param(index_);
+    auto result = std::vector<std::string_view>{};
+    result.reserve(param.valueCount);
+    for (auto index = param.firstValue; index < param.firstValue + param.valueCount; ++index)
+        result.push_back(image_->value(index));
+    return result;
+}
+
+CompiledNode::CompiledNode(const detail::CompiledImage& image, std::uint32_t index)
+    : image_{&image}
+    , index_{index}
+{
+}
+
+std::string_view CompiledNode::name() const
+{
+    return image_->string(image_->node(index_).name);
+}
+
+bool CompiledNode::isList() const
+{
+    return image_->node(index_).isList;
+}
+
+StreamPosition CompiledNode::position() const
+{
+    return detail::toStreamPosition(image_->node(index_).position);
+}
+
+std::size_t CompiledNode::paramsCount() const
+{
+    return image_->node(index_).paramCount;
+}
+
+bool CompiledNode::hasParam(std::string_view name) const
+{
+    return findParam(name) != notFound;
+}
+
+CompiledParam CompiledNode::param(std::string_view name) const
+{
+    const auto index = findParam(name);
+    if (index == notFound)
+        throw ConfigError{
+                "Config node '" + std::string{this->name()} + "' doesn't have a param '" + std::string{name} + "'",
+                position()};
+    return CompiledParam{*image_, index};
+}
+
+std::size_t CompiledNode::nodesCount() const
+{
+    const auto node = image_->node(index_);
+    return node.isList ? 0 : node.childCount;
+}
+
+bool CompiledNode::hasNode(std::string_view name) const
+{
+    return findNode(name) != notFound;
+}
+
+CompiledNode CompiledNode::node(std::string_view name) const
+{
+    const auto index = findNode(name);
+    if (index == notFound)
+        throw ConfigError{
+                "Config node '" + std::string{this->name()} + "' doesn't have a node '" + std::string{name} + "'",
+                position()};
+    return CompiledNode{*image_, index};
+}
+
+std::size_t CompiledNode::size() const
+{
+    const auto node = image_->node(index_);
+    return node.isList ? node.childCount : 0;
+}
+
+CompiledNode CompiledNode::at(std::size_t index) const
+{
+    const auto node = image_->node(index_);
+    Expects(node.isList && index < node.childCount);
+    return CompiledNode{*image_, node.firstChild + static_cast<std::uint32_t>(index)};
+}
+
+std::uint32_t CompiledNode::findParam(std::string_view name) const
+{
+    const auto node = image_->node(index_);
+    return findByName(
+            node.firstParam,
+            node.paramCount,
+            name,
+            [this](std::uint32_t index)
+            {
+                return image_->string(image_->param(index).name);
+            });
+}
+
+std::uint32_t CompiledNode::findNode(std::string_view name) const
+{
+    const auto node = image_->node(index_);
+    if (node.isList)
+        return notFound;
+    return findByName(
+            node.firstChild,
+            node.childCount,
+            name,
+            [this](std::uint32_t index)
+            {
+                return image_->string(image_->node(index).name);
+            });
+}
+
+CompiledConfig::CompiledConfig(std::unique_ptr<detail::MappedFile> file, std::string_view data)
+    : file_{std::move(file)}
+    , image_{std::make_unique<detail::CompiledImage>(data)}
+{
+}
+
+CompiledConfig::~CompiledConfig() = default;
+CompiledConfig::CompiledConfig(CompiledConfig&&) noexcept = default;
+CompiledConfig& CompiledConfig::operator=(CompiledConfig&&) noexcept = default;
+
+CompiledNode CompiledConfig::root() const
+{
+    return CompiledNode{*image_, 0};
+}
+
+Tree CompiledConfig::tree() const
+{
+    auto treeBuilder = detail::TreeBuilder{};
+    buildTree(*image_, image_->node(0), treeBuilder);
+    return treeBuilder.release();
+}
+
+} //namespace figcone::shoal
@@ -0,0 +1,119 @@
+#include "compiledimage.h"
+#include <figcone_tree/errors.h>
+#include <string>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+ConfigError imageError(const std::string& message)
+{
+    return ConfigError{"Invalid compiled config: " + message};
+}
+
+} //namespace
+
+CompiledImage::CompiledImage(std::string_view data)
+    : data_{data}
+    , header_{}
+{
+    if (data_.size() < sizeof(CompiledImageHeader) ||
+        std::string_view{data_.data(), compiledImageMagic.size()} != compiledImageMagic)
+        throw imageError("unknown format");
+    std::memcpy(&header_, data_.data(), sizeof(header_));
+    if (header_.version != compiledImageVersion)
+        throw imageError("unsupported version " + std::to_string(header_.version));
+    if (header_.byteOrderMark != compiledImageByteOrderMark)
+        throw imageError("it was compiled on a platform with a different byte order");
+
+    nodeTableOffset_ = sizeof(CompiledImageHeader);
+    paramTableOffset_ = nodeTableOffset_ + std::size_t{header_.nodeCount} * sizeof(CompiledNodeRecord);
+    valueTableOffset_ = paramTableOffset_ + std::size_t{header_.paramCount} * sizeof(CompiledParamRecord);
+    stringTableOffset_ = valueTableOffset_ + std::size_t{header_.valueCount} * sizeof(CompiledString);
+    if (header_.nodeCount == 0 || stringTableOffset_ + header_.stringTableSize != data_.size())
+        throw imageError("the size of the tables doesn't match the size of the data");
+
+    validate();
+}
+
+// Checks that the references stay inside the image, and that the nodes form a tree, so the readers of the image
+// don't need to check anything
+void CompiledImage::validate() const
+{
+    const auto isStringValid = [&](const CompiledString& str)
+    {
+        return std::uint64_t{str.offset} + str.size <= header_.stringTableSize;
+    };
+    const auto isRangeValid = [](std::uint32_t first, std::uint32_t count, std::uint32_t tableSize)
+    {
+        return std::uint64_t{first} + count <= tableSize;
+    };
+
+    auto nextChild = std::uint64_t{1};
+    for (auto index = std::uint32_t{}; index < header_.nodeCount; ++index) {
+        const auto nodeRecord = node(index);
+        if (!isStringValid(nodeRecord.name) || nodeRecord.isList > 1 ||
+            !isRangeValid(nodeRecord.firstParam, nodeRecord.paramCount, header_.paramCount) ||
+            (nodeRecord.isList && nodeRecord.paramCount > 0) || (index == 0 && nodeRecord.isList))
+            throw imageError("node #" + std::to_string(index) + " is broken");
+        // Breadth-first order gives every node except the root exactly one parent that precedes it
+        if (nodeRecord.firstChild != nextChild ||
+            !isRangeValid(nodeRecord.firstChild, nodeRecord.childCount, header_.nodeCount))
+            throw imageError("node #" + std::to_string(index) + " has broken child nodes");
+        nextChild += nodeRecord.childCount;
+
+        for (auto childIndex = nodeRecord.firstChild; childIndex < nodeRecord.firstChild + nodeRecord.childCount;
+             ++childIndex) {
+            const auto childRecord = node(childIndex);
+            if (!isStringValid(childRecord.name) || (nodeRecord.isList && childRecord.isList))
+                throw imageError("node #" + std::to_string(childIndex) + " is broken");
+            if (!nodeRecord.isList && childIndex > nodeRecord.firstChild &&
+                string(node(childIndex - 1).name) >= string(childRecord.name))
+                throw imageError("node #" + std::to_string(index) + " has unsorted child nodes");
+        }
+
+        for (auto paramIndex = nodeRecord.firstParam; paramIndex < nodeRecord.firstParam + nodeRecord.paramCount;
+             ++paramIndex) {
+            const auto paramRecord = param(paramIndex);
+            if (!isStringValid(paramRecord.name) || paramRecord.isList > 1 ||
+                !isRangeValid(paramRecord.firstValue, paramRecord.valueCount, header_.valueCount) ||
+                (!paramRecord.isList && paramRecord.valueCount != 1))
+                throw imageError("param #" + std::to_string(paramIndex) + " is broken");
+            if (paramIndex > nodeRecord.firstParam && string(param(paramIndex - 1).name) >= string(paramRecord.name))
+                throw imageError("node #" + std::to_string(index) + " has unsorted params");
+        }
+    }
+    if (nextChild != header_.nodeCount)
+        throw imageError("some nodes don't belong to the tree");
+
+    for (auto index = std::uint32_t{}; index < header_.valueCount; ++index)
+        if (!isStringValid(record<CompiledString>(valueTableOffset_, index)))
+            throw imageError("value #" + std::to_string(index) + " is broken");
+}
+
+std::uint32_t CompiledImage::nodeCount() const
+{
+    return header_.nodeCount;
+}
+
+CompiledNodeRecord CompiledImage::node(std::uint32_t index) const
+{
+    return record<CompiledNodeRecord>(nodeTableOffset_, index);
+}
+
+CompiledParamRecord CompiledImage::param(std::uint32_t index) const
+{
+    return record<CompiledParamRecord>(paramTableOffset_, index);
+}
+
+std::string_view CompiledImage::value(std::uint32_t index) const
+{
+    return string(record<CompiledString>(valueTableOffset_, index));
+}
+
+std::string_view CompiledImage::string(const CompiledString& str) const
+{
+    return data_.substr(stringTableOffset_ + str.offset, str.size);
+}
+
+} //namespace figcone::shoal::detail
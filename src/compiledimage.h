@@ -0,0 +1,108 @@
+#pragma once
+#include <figcone_tree/streamposition.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace figcone::shoal::detail {
+
+// Layout of the compiled config image. It doesn't contain pointers, all references are indices into its tables,
+// which follow the header in the order: nodes, params, values, string table.
+// Nodes are stored in breadth-first order, so the children of a node occupy a contiguous range of indices,
+// the root is the first node. Child nodes of a node and its params are sorted by name.
+constexpr auto compiledImageMagic = std::string_view{"SHOALBIN"};
+constexpr auto compiledImageVersion = std::uint32_t{1};
+constexpr auto compiledImageByteOrderMark = std::uint32_t{0x01020304};
+
+struct CompiledImageHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint32_t nodeCount;
+    std::uint32_t paramCount;
+    std::uint32_t valueCount;
+    std::uint32_t stringTableSize;
+};
+
+struct CompiledString {
+    std::uint32_t offset;
+    std::uint32_t size;
+};
+
+// Missing line or column is stored as -1
+struct CompiledPosition {
+    std::int32_t line;
+    std::int32_t column;
+};
+
+// List elements have the name of their list
+struct CompiledNodeRecord {
+    CompiledString name;
+    CompiledPosition position;
+    std::uint32_t isList;
+    std::uint32_t firstParam;
+    std::uint32_t paramCount;
+    std::uint32_t firstChild;
+    std::uint32_t childCount;
+};
+
+struct CompiledParamRecord {
+    CompiledString name;
+    CompiledPosition position;
+    std::uint32_t isList;
+    std::uint32_t firstValue;
+    std::uint32_t valueCount;
+};
+
+// Records are written as they are, so they mustn't have padding
+static_assert(sizeof(CompiledImageHeader) == 32);
+static_assert(sizeof(CompiledNodeRecord) == 36);
+static_assert(sizeof(CompiledParamRecord) == 28);
+
+// Validated image, the records are copied out of the data, as the image doesn't have to be aligned
+class CompiledImage {
+public:
+    // Throws ConfigError if the data isn't a valid image
+    explicit CompiledImage(std::string_view data);
+
+    std::uint32_t nodeCount() const;
+    CompiledNodeRecord node(std::uint32_t index) const;
+    CompiledParamRecord param(std::uint32_t index) const;
+    std::string_view value(std::uint32_t index) const;
+    std::string_view string(const CompiledString& str) const;
+
+private:
+    template<typename T>
+    T record(std::size_t tableOffset, std::uint32_t index) const
+    {
+        auto result = T{};
+        std::memcpy(&result, data_.data() + tableOffset + index * sizeof(T), sizeof(T));
+        return result;
+    }
+    void validate() const;
+
+private:
+    std::string_view data_;
+    CompiledImageHeader header_;
+    std::size_t nodeTableOffset_ = 0;
+    std::size_t paramTableOffset_ = 0;
+    std::size_t valueTableOffset_ = 0;
+    std::size_t stringTableOffset_ = 0;
+};
+
+inline CompiledPosition toCompiledPosition(const StreamPosition& position)
+{
+    return {position.line.value_or(-1), position.column.value_or(-1)};
+}
+
+inline StreamPosition toStreamPosition(const CompiledPosition& position)
+{
+    auto result = StreamPosition{};
+    if (position.line != -1)
+        result.line = position.line;
+    if (position.column != -1)
+        result.column = position.column;
+    return result;
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,178 @@
+#include "compiledimagebuilder.h"
+#include <figcone_tree/errors.h>
+#include <gsl/assert>
+#include <algorithm>
+#include <limits>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+std::uint32_t toUint32(std::size_t value)
+{
+    if (value > std::numeric_limits<std::uint32_t>::max())
+        throw ConfigError{"Config is too large to be compiled"};
+    return static_cast<std::uint32_t>(value);
+}
+
+template<typename T>
+void appendRecords(std::string& data, const std::vector<T>& records)
+{
+    data.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+}
+
+} //namespace
+
+CompiledImageBuilder::CompiledImageBuilder()
+    : root_{std::make_unique<Node>(Node{{}, false, {}, {}, {}})}
+{
+    nodeStack_.push_back(root_.get());
+}
+
+void CompiledImageBuilder::onNodeBegin(std::string_view name, const StreamPosition& position)
+{
+    nodeStack_.push_back(&addNode(name, false, position));
+}
+
+void CompiledImageBuilder::onNodeListBegin(std::string_view name, const StreamPosition& position)
+{
+    nodeStack_.push_back(&addNode(name, true, position));
+}
+
+void CompiledImageBuilder::onListElement(const StreamPosition& position)
+{
+    nodeStack_.push_back(&addNode(nodeStack_.back()->name, false, position));
+}
+
+void CompiledImageBuilder::onParam(std::string_view name, std::string_view value, const ParamPosition& position)
+{
+    nodeStack_.back()->params.push_back({std::string{name}, false, {std::string{value}}, position.resolve()});
+}
+
+void CompiledImageBuilder::onParamList(
+        std::string_view name,
+        const std::vector<std::string_view>& valueList,
+        const ParamPosition& position)
+{
+    nodeStack_.back()->params.push_back(
+            {std::string{name},
+             true,
+             std::vector<std::string>{valueList.begin(), valueList.end()},
+             position.resolve()});
+}
+
+void CompiledImageBuilder::onNodeEnd()
+{
+    Expects(nodeStack_.size() > 1);
+    nodeStack_.pop_back();
+}
+
+CompiledImageBuilder::Node& CompiledImageBuilder::addNode(
+        std::string_view name,
+        bool isList,
+        const StreamPosition& position)
+{
+    auto& nodes = nodeStack_.back()->nodes;
+    nodes.push_back(std::make_unique<Node>(Node{std::string{name}, isList, position, {}, {}}));
+    return *nodes.back();
+}
+
+CompiledString CompiledImageBuilder::addString(const std::string& str)
+{
+    const auto it = strings_.find(str);
+    if (it != strings_.end())
+        return it->second;
+
+    const auto result = CompiledString{toUint32(stringTable_.size()), toUint32(str.size())};
+    stringTable_ += str;
+    strings_.emplace(str, result);
+    return result;
+}
+
+std::string CompiledImageBuilder::release()
+{
+    Expects(nodeStack_.size() == 1);
+    auto nodeRecords = std::vector<CompiledNodeRecord>{};
+    auto paramRecords = std::vector<CompiledParamRecord>{};
+    auto valueRecords = std::vector<CompiledString>{};
+
+    // Nodes are numbered in breadth-first order, so the children of a node get consecutive indices
+    auto nodeQueue = std::vector<Node*>{root_.get()};
+    for (auto nodeIndex = std::size_t{}; nodeIndex < nodeQueue.size(); ++nodeIndex) {
+        auto& node = *nodeQueue[nodeIndex];
+        if (!node.isList)
+            std::sort(
+                    node.nodes.begin(),
+                    node.nodes.end(),
+                    [](const std::unique_ptr<Node>& lhs, const std::unique_ptr<Node>& rhs)
+                    {
+                        return lhs->name < rhs->name;
+                    });
+        // Repeated params are removed, as figcone::Tree keeps the first one
+        std::stable_sort(
+                node.params.begin(),
+                node.params.end(),
+                [](const Param& lhs, const Param& rhs)
+                {
+                    return lhs.name < rhs.name;
+                });
+        node.params.erase(
+                std::unique(
+                        node.params.begin(),
+                        node.params.end(),
+                        [](const Param& lhs, const Param& rhs)
+                        {
+                            return lhs.name == rhs.name;
+                        }),
+                node.params.end());
+
+        nodeRecords.push_back(
+                {addString(node.name),
+                 toCompiledPosition(node.position),
+                 node.isList,
+                 toUint32(paramRecords.size()),
+                 toUint32(node.params.size()),
+                 toUint32(nodeQueue.size()),
+                 toUint32(node.nodes.size())});
+        for (const auto& param : node.params) {
+            paramRecords.push_back(
+                    {addString(param.name),
+                     toCompiledPosition(param.position),
+                     param.isList,
+                     toUint32(valueRecords.size()),
+                     toUint32(param.valueList.size())});
+            for (const auto& value : param.valueList)
+                valueRecords.push_back(addString(value));
+        }
+        for (const auto& childNode : node.nodes)
+            nodeQueue.push_back(childNode.get());
+    }
+
+    auto header = CompiledImageHeader{};
+    std::copy(compiledImageMagic.begin(), compiledImageMagic.end(), header.magic);
+    header.version = compiledImageVersion;
+    header.byteOrderMark = compiledImageByteOrderMark;
+    header.nodeCount = toUint32(nodeRecords.size());
+    header.paramCount = toUint32(paramRecords.size());
+    header.valueCount = toUint32(valueRecords.size());
+    header.stringTableSize = toUint32(stringTable_.size());
+
+    auto result = std::string{};
+    result.reserve(
+            sizeof(header) + nodeRecords.size() * sizeof(CompiledNodeRecord) +
+            paramRecords.size() * sizeof(CompiledParamRecord) + valueRecords.size() * sizeof(CompiledString) +
+            stringTable_.size());
+    result.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendRecords(result, nodeRecords);
+    appendRecords(result, paramRecords);
+    appendRecords(result, valueRecords);
+    result += stringTable_;
+
+    root_ = std::make_unique<Node>(Node{{}, false, {}, {}, {}});
+    nodeStack_ = {root_.get()};
+    stringTable_.clear();
+    strings_.clear();
+    return result;
+}
+
+} //namespace figcone::shoal::detail
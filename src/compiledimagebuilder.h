@@ -0,0 +1,53 @@
+#pragma once
+#include "compiledimage.h"
+#include <figcone_shoal/ieventhandler.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+// Collects the parsing events and serializes them into a compiled config image
+class CompiledImageBuilder : public IEventHandler {
+    struct Param {
+        std::string name;
+        bool isList;
+        std::vector<std::string> valueList;
+        StreamPosition position;
+    };
+
+    struct Node {
+        std::string name;
+        bool isList;
+        StreamPosition position;
+        std::vector<Param> params;
+        std::vector<std::unique_ptr<Node>> nodes;
+    };
+
+public:
+    CompiledImageBuilder();
+    void onNodeBegin(std::string_view name, const StreamPosition& position) override;
+    void onNodeListBegin(std::string_view name, const StreamPosition& position) override;
+    void onListElement(const StreamPosition& position) override;
+    void onParam(std::string_view name, std::string_view value, const ParamPosition& position) override;
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position) override;
+    void onNodeEnd() override;
+
+    std::string release();
+
+private:
+    Node& addNode(std::string_view name, bool isList, const StreamPosition& position);
+    CompiledString addString(const std::string& str);
+
+private:
+    std::unique_ptr<Node> root_;
+    std::vector<Node*> nodeStack_;
+    std::string stringTable_;
+    std::unordered_map<std::string, CompiledString> strings_;
+};
+
+} //namespace figcone::shoal::detail
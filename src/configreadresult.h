@@ -1,6 +1,7 @@
 #pragma once
-#include <figcone_tree/streamposition.h>
-#include <string>
+#include <cstddef>
+#include <optional>
+#include <string_view>
 
 namespace figcone::shoal::detail {
 
@@ -11,8 +12,8 @@ struct ConfigReadResult {
         ReturnToNodeByName,
         ReturnToRootNode
     } nextAction;
-    std::string parentNodeName;
-    StreamPosition returnToNodeStreamPosition;
+    std::string_view parentNodeName;
+    std::optional<std::size_t> returnToNodeOffset;
 };
 
 } //namespace figcone::shoal::detail
\ No newline at end of file
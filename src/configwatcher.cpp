@@ -0,0 +1,197 @@
+#ifdef __linux__
+
+#include <figcone_shoal/configwatcher.h>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace figcone::shoal {
+
+namespace {
+
+constexpr auto directoryEvents = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+bool readFile(const std::filesystem::path& path, std::string& content)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file)
+        return false;
+    content.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    return !file.bad();
+}
+
+} //namespace
+
+ConfigWatcher::ConfigWatcher(TreeHandler treeHandler, ErrorHandler errorHandler, Parser parser)
+    : treeHandler_{std::move(treeHandler)}
+    , errorHandler_{std::move(errorHandler)}
+    , parser_{std::move(parser)}
+    , inotifyFd_{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+    , stopEventFd_{eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+{
+    if (inotifyFd_ == -1 || stopEventFd_ == -1) {
+        if (inotifyFd_ != -1)
+            close(inotifyFd_);
+        if (stopEventFd_ != -1)
+            close(stopEventFd_);
+        throw ConfigError{"Can't start watching config files"};
+    }
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    stop();
+    close(inotifyFd_);
+    close(stopEventFd_);
+}
+
+Tree ConfigWatcher::watch(const std::filesystem::path& path)
+{
+    const auto filePath = std::filesystem::absolute(path);
+    const auto directoryWatch = inotify_add_watch(inotifyFd_, filePath.parent_path().c_str(), directoryEvents);
+    if (directoryWatch == -1)
+        throw ConfigError{"Can't watch config file '" + path.string() + "'"};
+
+    auto content = std::string{};
+    if (!readFile(filePath, content))
+        throw ConfigError{"Can't open config file '" + path.string() + "' for reading"};
+    auto tree = parser_.parse(std::string_view{content});
+    files_.push_back(
+            {filePath,
+             directoryWatch,
+             filePath.filename().string(),
+             content.size(),
+             std::hash<std::string_view>{}(content),
+             false,
+             {}});
+    return tree;
+}
+
+void ConfigWatcher::setDebounceDelay(std::chrono::milliseconds delay)
+{
+    debounceDelay_ = delay;
+}
+
+std::size_t ConfigWatcher::processEvents(std::chrono::milliseconds timeout)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + timeout;
+    auto publishedCount = std::size_t{};
+    while (true) {
+        const auto now = Clock::now();
+        for (auto& file : files_)
+            if (file.isChanged && now - file.changeTime >= debounceDelay_) {
+                file.isChanged = false;
+                if (reload(file))
+                    publishedCount++;
+            }
+        if (publishedCount > 0 || now >= deadline || isStopRequested_)
+            return publishedCount;
+
+        // Waits for new events, or until the earliest change is old enough to be processed
+        auto waitEnd = deadline;
+        for (const auto& file : files_)
+            if (file.isChanged)
+                waitEnd = std::min(waitEnd, file.changeTime + debounceDelay_);
+        const auto waitTime = std::min<std::chrono::milliseconds::rep>(
+                std::chrono::ceil<std::chrono::milliseconds>(waitEnd - now).count(),
+                std::numeric_limits<int>::max());
+
+        pollfd fds[] = {{inotifyFd_, POLLIN, 0}, {stopEventFd_, POLLIN, 0}};
+        if (poll(fds, 2, static_cast<int>(waitTime)) > 0 && (fds[0].revents & POLLIN))
+            readEvents();
+    }
+}
+
+void ConfigWatcher::readEvents()
+{
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const auto size = read(inotifyFd_, buffer, sizeof(buffer));
+        if (size <= 0)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+        for (auto pos = ssize_t{}; pos < size;) {
+            const auto& event = *reinterpret_cast<const inotify_event*>(buffer + pos);
+            pos += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+
+            // Lost events can belong to any file
+            const auto isOverflow = (event.mask & IN_Q_OVERFLOW) != 0;
+            const auto fileName = event.len ? std::string_view{event.name} : std::string_view{};
+            for (auto& file : files_)
+                if (isOverflow || (file.directoryWatch == event.wd && file.fileName == fileName)) {
+                    file.isChanged = true;
+                    file.changeTime = now;
+                }
+        }
+    }
+}
+
+bool ConfigWatcher::reload(WatchedFile& file)
+{
+    // The file can be missing while it's being replaced, the next event will report it
+    auto content = std::string{};
+    if (!readFile(file.path, content))
+        return false;
+
+    const auto contentHash = std::hash<std::string_view>{}(content);
+    if (content.size() == file.contentSize && contentHash == file.contentHash)
+        return false;
+    file.contentSize = content.size();
+    file.contentHash = contentHash;
+
+    try {
+        auto tree = parser_.parse(std::string_view{content});
+        treeHandler_(file.path, std::move(tree));
+        return true;
+    }
+    catch (const ConfigError& error) {
+        if (errorHandler_)
+            errorHandler_(file.path, error);
+        return false;
+    }
+    // Other exceptions of the parser or the tree handler must not escape the background thread
+    catch (const std::exception& error) {
+        if (errorHandler_)
+            errorHandler_(file.path, ConfigError{error.what()});
+        return false;
+    }
+}
+
+void ConfigWatcher::start()
+{
+    if (thread_.joinable())
+        return;
+    isStopRequested_ = false;
+    thread_ = std::thread{[this]
+                          {
+                              while (!isStopRequested_)
+                                  processEvents(std::chrono::hours{1});
+                          }};
+}
+
+void ConfigWatcher::stop()
+{
+    if (!thread_.joinable())
+        return;
+    isStopRequested_ = true;
+    const auto value = std::uint64_t{1};
+    [[maybe_unused]] const auto result = write(stopEventFd_, &value, sizeof(value));
+    thread_.join();
+
+    auto counter = std::uint64_t{};
+    [[maybe_unused]] const auto readResult = read(stopEventFd_, &counter, sizeof(counter));
+}
+
+} //namespace figcone::shoal
+
+#endif //__linux__
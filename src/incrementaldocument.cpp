@@ -0,0 +1,356 @@
+#include "configreadresult.h"
+#include "nodeparser.h"
+#include "nodereader.h"
+#include "stream.h"
+#include "treebuilder.h"
+#include "utils.h"
+#include <figcone_shoal/incrementaldocument.h>
+#include <gsl/assert>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+struct DocumentParam {
+    std::string name;
+    std::vector<std::string> valueList;
+    bool isList;
+};
+
+struct DocumentSection {
+    enum class Type {
+        Root,
+        Node,
+        NodeList,
+        ListElement
+    };
+
+    Type type;
+    // List elements have the name of their list
+    std::string name;
+    StreamPosition position;
+    // Node sections begin at their header, list elements at their content
+    std::size_t beginOffset = 0;
+    // Edits after this offset don't change how the section begins: it's the end of the node's header line
+    // or the beginning of the element's content
+    std::size_t bodyOffset = 0;
+    // Offset where the reading of the section has finished with the result passed to its parent
+    std::size_t endOffset = 0;
+    ConfigReadResult::NextAction nextAction = ConfigReadResult::NextAction::ContinueReading;
+    std::string closedNodeName;
+    // Positions of params aren't stored, as figcone::Tree doesn't keep them
+    std::vector<DocumentParam> params;
+    std::vector<std::unique_ptr<DocumentSection>> sections;
+};
+
+namespace {
+
+struct TextEdit {
+    std::size_t size;
+    std::size_t replacementSize;
+    StreamPosition oldEndPosition;
+    StreamPosition newEndPosition;
+};
+
+std::size_t lineBegin(std::string_view data, std::size_t offset)
+{
+    const auto lineSeparatorPos = data.substr(0, offset).find_last_of("\r\n");
+    return lineSeparatorPos == std::string_view::npos ? 0 : lineSeparatorPos + 1;
+}
+
+std::size_t lineEnd(std::string_view data, std::size_t offset)
+{
+    return std::min(data.find_first_of("\r\n", offset), data.size());
+}
+
+std::unique_ptr<DocumentSection> makeSection(
+        DocumentSection::Type type,
+        std::string_view name,
+        const StreamPosition& position,
+        std::size_t beginOffset,
+        std::size_t bodyOffset)
+{
+    auto section = std::make_unique<DocumentSection>();
+    section->type = type;
+    section->name = std::string{name};
+    section->position = position;
+    section->beginOffset = beginOffset;
+    section->bodyOffset = bodyOffset;
+    return section;
+}
+
+// Reads the content of the reader's current node, the stream's offsets start at baseOffset of the text
+void readSection(
+        NodeReader& reader,
+        Stream& stream,
+        std::string_view text,
+        std::size_t baseOffset,
+        DocumentSection& section)
+{
+    while (true) {
+        switch (reader.next()) {
+        case ReaderEvent::NodeBegin:
+        case ReaderEvent::NodeListBegin: {
+            const auto offset = baseOffset + reader.eventOffset();
+            auto node = makeSection(
+                    reader.event() == ReaderEvent::NodeListBegin ? DocumentSection::Type::NodeList
+                                                                 : DocumentSection::Type::Node,
+                    reader.name(),
+                    stream.position(reader.eventOffset()),
+                    offset,
+                    lineEnd(text, offset));
+            readSection(reader, stream, text, baseOffset, *node);
+            section.sections.push_back(std::move(node));
+            break;
+        }
+        case ReaderEvent::ListElement: {
+            const auto offset = baseOffset + reader.eventOffset();
+            auto element = makeSection(
+                    DocumentSection::Type::ListElement,
+                    reader.name(),
+                    stream.position(reader.eventOffset()),
+                    offset,
+                    offset);
+            readSection(reader, stream, text, baseOffset, *element);
+            section.sections.push_back(std::move(element));
+            break;
+        }
+        case ReaderEvent::Param:
+        case ReaderEvent::ParamList: {
+            const auto& param = reader.param();
+            section.params.push_back(
+                    {std::string{param.name},
+                     std::vector<std::string>{param.valueList.begin(), param.valueList.end()},
+                     param.isList});
+            break;
+        }
+        case ReaderEvent::NodeEnd:
+        case ReaderEvent::DocumentEnd: {
+            const auto& readResult = reader.readResult();
+            section.endOffset = baseOffset + stream.offset();
+            section.nextAction = readResult.nextAction;
+            section.closedNodeName = std::string{readResult.parentNodeName};
+            return;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+std::unique_ptr<DocumentSection> parseDocument(std::string_view text)
+{
+    auto stream = Stream{text};
+    auto reader = NodeReader{stream};
+    auto root = makeSection(DocumentSection::Type::Root, {}, StreamPosition{}, 0, 0);
+    readSection(reader, stream, text, 0, *root);
+    return root;
+}
+
+// Streams used to read a section again start at the beginning of its first line, so the columns of the positions
+// are right without indexing the preceding text
+Stream makeSectionStream(std::string_view text, const DocumentSection& section, std::size_t& baseOffset)
+{
+    baseOffset = lineBegin(text, section.beginOffset);
+    return Stream{text.substr(baseOffset), StreamPosition{*section.position.line, 1}};
+}
+
+// The text up to the section's body offset must be the same as the one the section was read from
+std::unique_ptr<DocumentSection> reparseSection(std::string_view text, const DocumentSection& oldSection)
+{
+    auto baseOffset = std::size_t{};
+    auto stream = makeSectionStream(text, oldSection, baseOffset);
+    stream.skipTo(oldSection.beginOffset - baseOffset);
+    auto section = makeSection(
+            oldSection.type,
+            oldSection.name,
+            oldSection.position,
+            oldSection.beginOffset,
+            oldSection.bodyOffset);
+
+    if (oldSection.type == DocumentSection::Type::ListElement) {
+        auto reader = NodeReader{stream, oldSection.name};
+        readSection(reader, stream, text, baseOffset, *section);
+        return section;
+    }
+
+    // Sibling nodes are already checked to have different names
+    auto parent = OpenNode{stream.arena(), false, false};
+    const auto header = valueOrThrow(readNodeHeader(stream, parent));
+    section->type = header.isList ? DocumentSection::Type::NodeList : DocumentSection::Type::Node;
+    auto reader = NodeReader{stream, header.name, header.isList};
+    readSection(reader, stream, text, baseOffset, *section);
+    return section;
+}
+
+StreamPosition sectionTextPosition(std::string_view text, const DocumentSection& section, std::size_t offset)
+{
+    auto baseOffset = std::size_t{};
+    auto stream = makeSectionStream(text, section, baseOffset);
+    return stream.position(offset - baseOffset);
+}
+
+// Moves the section that follows the edited region
+void shiftSection(DocumentSection& section, const TextEdit& edit)
+{
+    section.beginOffset = section.beginOffset - edit.size + edit.replacementSize;
+    section.bodyOffset = section.bodyOffset - edit.size + edit.replacementSize;
+    section.endOffset = section.endOffset - edit.size + edit.replacementSize;
+    if (section.position.line == edit.oldEndPosition.line)
+        section.position.column =
+                *section.position.column - *edit.oldEndPosition.column + *edit.newEndPosition.column;
+    section.position.line = *section.position.line - *edit.oldEndPosition.line + *edit.newEndPosition.line;
+
+    for (auto& childSection : section.sections)
+        shiftSection(*childSection, edit);
+}
+
+void buildTree(const DocumentSection& section, TreeBuilder& treeBuilder)
+{
+    for (const auto& param : section.params) {
+        if (param.isList)
+            treeBuilder.onParamList(
+                    param.name,
+                    std::vector<std::string_view>{param.valueList.begin(), param.valueList.end()},
+                    {});
+        else
+            treeBuilder.onParam(param.name, param.valueList.at(0), {});
+    }
+
+    for (const auto& childSection : section.sections) {
+        switch (childSection->type) {
+        case DocumentSection::Type::Node:
+            treeBuilder.onNodeBegin(childSection->name, childSection->position);
+            break;
+        case DocumentSection::Type::NodeList:
+            treeBuilder.onNodeListBegin(childSection->name, childSection->position);
+            break;
+        case DocumentSection::Type::ListElement:
+            treeBuilder.onListElement(childSection->position);
+            break;
+        default:
+            break;
+        }
+        buildTree(*childSection, treeBuilder);
+        treeBuilder.onNodeEnd();
+    }
+}
+
+} //namespace
+
+} //namespace figcone::shoal::detail
+
+namespace figcone::shoal {
+
+IncrementalDocument::IncrementalDocument(std::string text)
+    : text_{std::move(text)}
+    , root_{detail::parseDocument(text_)}
+    , reparsedSize_{text_.size()}
+{
+}
+
+IncrementalDocument::~IncrementalDocument() = default;
+IncrementalDocument::IncrementalDocument(IncrementalDocument&&) noexcept = default;
+IncrementalDocument& IncrementalDocument::operator=(IncrementalDocument&&) noexcept = default;
+
+const std::string& IncrementalDocument::text() const
+{
+    return text_;
+}
+
+Tree IncrementalDocument::tree() const
+{
+    auto treeBuilder = detail::TreeBuilder{};
+    detail::buildTree(*root_, treeBuilder);
+    return treeBuilder.release();
+}
+
+void IncrementalDocument::update(std::string text)
+{
+    const auto prefixSize = static_cast<std::size_t>(
+            std::mismatch(text_.begin(), text_.begin() + std::min(text_.size(), text.size()), text.begin()).first -
+            text_.begin());
+    const auto maxSuffixSize = std::min(text_.size(), text.size()) - prefixSize;
+    const auto suffixSize = static_cast<std::size_t>(
+            std::mismatch(text_.rbegin(), text_.rbegin() + maxSuffixSize, text.rbegin()).first - text_.rbegin());
+
+    const auto size = text_.size() - prefixSize - suffixSize;
+    const auto replacementSize = text.size() - prefixSize - suffixSize;
+    applyEdit(std::move(text), prefixSize, size, replacementSize);
+}
+
+void IncrementalDocument::update(std::size_t offset, std::size_t size, std::string_view replacement)
+{
+    Expects(offset + size <= text_.size());
+    auto text = std::string{};
+    text.reserve(text_.size() - size + replacement.size());
+    text.append(text_, 0, offset);
+    text.append(replacement);
+    text.append(text_, offset + size);
+    applyEdit(std::move(text), offset, size, replacement.size());
+}
+
+std::size_t IncrementalDocument::reparsedSize() const
+{
+    return reparsedSize_;
+}
+
+void IncrementalDocument::applyEdit(std::string text, std::size_t offset, std::size_t size, std::size_t replacementSize)
+{
+    using detail::DocumentSection;
+    const auto editEnd = offset + size;
+
+    // Path to the smallest section enclosing the edit, as the pairs of the parent and the section's index in it
+    auto path = std::vector<std::pair<DocumentSection*, std::size_t>>{};
+    for (auto parent = root_.get();;) {
+        const auto& sections = parent->sections;
+        const auto it = std::partition_point(
+                sections.begin(),
+                sections.end(),
+                [&](const std::unique_ptr<DocumentSection>& section)
+                {
+                    return section->bodyOffset < offset;
+                });
+        if (it == sections.begin() || editEnd > (*std::prev(it))->endOffset)
+            break;
+        path.emplace_back(parent, static_cast<std::size_t>(std::prev(it) - sections.begin()));
+        parent = std::prev(it)->get();
+    }
+
+    // The section can replace the old one only if its reading has finished with the same result at the same place,
+    // otherwise the reading of its parent changes too
+    for (auto pathSize = path.size(); pathSize > 0; --pathSize) {
+        const auto [parent, index] = path[pathSize - 1];
+        const auto& oldSection = *parent->sections[index];
+        auto section = detail::reparseSection(text, oldSection);
+        if (section->endOffset != oldSection.endOffset - size + replacementSize ||
+            section->nextAction != oldSection.nextAction || section->closedNodeName != oldSection.closedNodeName)
+            continue;
+
+        // The following positions are shifted relative to a position after the edit, which mustn't be
+        // between the characters of the "\r\n" line separator
+        const auto shiftBase = editEnd < text_.size() && text_[editEnd] == '\n' ? 1 : 0;
+        const auto edit = detail::TextEdit{
+                size,
+                replacementSize,
+                detail::sectionTextPosition(text_, oldSection, editEnd + shiftBase),
+                detail::sectionTextPosition(text, *section, offset + replacementSize + shiftBase)};
+        reparsedSize_ = section->endOffset - section->beginOffset;
+        parent->sections[index] = std::move(section);
+        for (auto i = std::size_t{}; i < pathSize; ++i) {
+            auto& [ancestor, ancestorChildIndex] = path[i];
+            ancestor->endOffset = ancestor->endOffset - size + replacementSize;
+            for (auto j = ancestorChildIndex + 1; j < ancestor->sections.size(); ++j)
+                detail::shiftSection(*ancestor->sections[j], edit);
+        }
+        text_ = std::move(text);
+        return;
+    }
+
+    root_ = detail::parseDocument(text);
+    text_ = std::move(text);
+    reparsedSize_ = text_.size();
+}
+
+} //namespace figcone::shoal
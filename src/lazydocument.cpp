@@ -0,0 +1,81 @@
+#include "lazyindexbuilder.h"
+#include "mappedfile.h"
+#include <figcone_shoal/lazydocument.h>
+#include <figcone_tree/errors.h>
+#include <gsl/assert>
+
+namespace figcone::shoal {
+
+LazyNode::LazyNode(std::string_view data, std::string name, bool isList, const StreamPosition& position)
+    : data_{data}
+    , name_{std::move(name)}
+    , isList_{isList}
+    , position_{position}
+{
+}
+
+const std::string& LazyNode::name() const
+{
+    return name_;
+}
+
+bool LazyNode::isList() const
+{
+    return isList_;
+}
+
+const StreamPosition& LazyNode::position() const
+{
+    return position_;
+}
+
+bool LazyNode::hasNode(std::string_view name) const
+{
+    return nodes_.find(name) != nodes_.end();
+}
+
+const LazyNode& LazyNode::node(std::string_view name) const
+{
+    const auto it = nodes_.find(name);
+    if (it == nodes_.end())
+        throw ConfigError{"Config node '" + name_ + "' doesn't have a node '" + std::string{name} + "'", position_};
+    return *it->second;
+}
+
+std::size_t LazyNode::nodesCount() const
+{
+    return nodes_.size();
+}
+
+std::size_t LazyNode::size() const
+{
+    return elements_.size();
+}
+
+const LazyNode& LazyNode::at(std::size_t index) const
+{
+    Expects(index < elements_.size());
+    return *elements_[index];
+}
+
+const TreeNode& LazyNode::tree() const
+{
+    return detail::LazyIndexBuilder::parse(*this).root();
+}
+
+LazyDocument::LazyDocument(std::unique_ptr<detail::MappedFile> file, std::unique_ptr<LazyNode> root)
+    : file_{std::move(file)}
+    , root_{std::move(root)}
+{
+}
+
+LazyDocument::~LazyDocument() = default;
+LazyDocument::LazyDocument(LazyDocument&&) noexcept = default;
+LazyDocument& LazyDocument::operator=(LazyDocument&&) noexcept = default;
+
+const LazyNode& LazyDocument::root() const
+{
+    return *root_;
+}
+
+} //namespace figcone::shoal
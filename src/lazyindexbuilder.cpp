@@ -0,0 +1,101 @@
+#include "lazyindexbuilder.h"
+#include "mappedfile.h"
+#include "nodeparser.h"
+#include "nodereader.h"
+#include "stream.h"
+#include "treebuilder.h"
+#include "utils.h"
+#include <gsl/assert>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+std::size_t lineBegin(std::string_view data, std::size_t offset)
+{
+    const auto lineSeparatorPos = data.substr(0, offset).find_last_of("\r\n");
+    return lineSeparatorPos == std::string_view::npos ? 0 : lineSeparatorPos + 1;
+}
+
+std::size_t nextLineBegin(std::string_view data, std::size_t offset)
+{
+    const auto lineSeparatorPos = data.find_first_of("\r\n", offset);
+    if (lineSeparatorPos == std::string_view::npos)
+        return data.size();
+    if (data[lineSeparatorPos] == '\r' && data.substr(lineSeparatorPos + 1, 1) == "\n")
+        return lineSeparatorPos + 2;
+    return lineSeparatorPos + 1;
+}
+
+} //namespace
+
+LazyDocument LazyIndexBuilder::build(std::string_view data, std::unique_ptr<MappedFile> file)
+{
+    auto stream = Stream{data};
+    auto reader = NodeReader{stream};
+    auto rootNode = std::unique_ptr<LazyNode>{new LazyNode{data, {}, false, StreamPosition{}}};
+    auto nodeStack = std::vector<LazyNode*>{rootNode.get()};
+
+    // Node content starts after its header line, which can be the last line of the document without a line separator
+    const auto setContentBegin = [&](LazyNode& node, std::size_t minContentBegin)
+    {
+        const auto offset = stream.offset();
+        node.contentBegin_ = std::max(lineBegin(data, offset), minContentBegin);
+        node.contentLine_ = *stream.position(offset).line;
+    };
+
+    while (true) {
+        switch (reader.next()) {
+        case ReaderEvent::NodeBegin:
+        case ReaderEvent::NodeListBegin: {
+            auto node = std::unique_ptr<LazyNode>{new LazyNode{
+                    data,
+                    std::string{reader.name()},
+                    reader.event() == ReaderEvent::NodeListBegin,
+                    stream.position(reader.eventOffset())}};
+            setContentBegin(*node, nextLineBegin(data, reader.eventOffset()));
+            auto& parent = *nodeStack.back();
+            nodeStack.push_back(node.get());
+            parent.nodes_.emplace(node->name_, std::move(node));
+            break;
+        }
+        case ReaderEvent::ListElement: {
+            auto node = std::unique_ptr<LazyNode>{
+                    new LazyNode{data, std::string{reader.name()}, false, stream.position(reader.eventOffset())}};
+            setContentBegin(*node, 0);
+            auto& parent = *nodeStack.back();
+            nodeStack.push_back(node.get());
+            parent.elements_.push_back(std::move(node));
+            break;
+        }
+        case ReaderEvent::NodeEnd:
+            nodeStack.back()->contentEnd_ = reader.eventOffset();
+            nodeStack.pop_back();
+            break;
+        case ReaderEvent::DocumentEnd:
+            Expects(nodeStack.size() == 1);
+            rootNode->contentEnd_ = data.size();
+            return LazyDocument{std::move(file), std::move(rootNode)};
+        default:
+            break;
+        }
+    }
+}
+
+const Tree& LazyIndexBuilder::parse(const LazyNode& node)
+{
+    Expects(!node.isList_);
+    if (!node.tree_) {
+        const auto content = node.data_.substr(node.contentBegin_, node.contentEnd_ - node.contentBegin_);
+        auto stream = Stream{content, StreamPosition{node.contentLine_, 1}};
+        auto treeBuilder = TreeBuilder{};
+        valueOrThrow(parseRootNode(stream, treeBuilder));
+        node.tree_ = std::make_unique<Tree>(treeBuilder.release());
+    }
+    return *node.tree_;
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,17 @@
+#pragma once
+#include <figcone_shoal/lazydocument.h>
+#include <memory>
+#include <string_view>
+
+namespace figcone::shoal::detail {
+class MappedFile;
+
+class LazyIndexBuilder {
+public:
+    // Reads the whole document to check it and index its nodes, without building the trees of their content.
+    // The data must stay alive while the result is used, unless it's owned by file
+    static LazyDocument build(std::string_view data, std::unique_ptr<MappedFile> file = nullptr);
+    static const Tree& parse(const LazyNode& node);
+};
+
+} //namespace figcone::shoal::detail
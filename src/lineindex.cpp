@@ -0,0 +1,47 @@
+#include "lineindex.h"
+#include "charscan.h"
+#include <gsl/assert>
+#include <algorithm>
+
+namespace figcone::shoal::detail {
+
+namespace {
+constexpr auto indexedChars = CharSet{"\r\n\t"};
+}
+
+void LineIndex::extend(std::string_view data)
+{
+    const auto begin = data.data();
+    const auto end = data.data() + data.size();
+    for (auto it = findFirstOf(begin, end, indexedChars); it != end; it = findFirstOf(it + 1, end, indexedChars)) {
+        const auto offset = size_ + static_cast<std::size_t>(it - begin);
+        const auto prevChar = it == begin ? lastChar_ : *(it - 1);
+        if (*it == '\t')
+            tabOffsets_.push_back(offset);
+        else if (*it == '\n' && prevChar == '\r')
+            lineStarts_.back() = offset + 1;
+        else
+            lineStarts_.push_back(offset + 1);
+    }
+    if (!data.empty())
+        lastChar_ = data.back();
+    size_ += data.size();
+}
+
+std::size_t LineIndex::size() const
+{
+    return size_;
+}
+
+TextPosition LineIndex::position(std::size_t offset) const
+{
+    Expects(offset <= size_);
+    const auto lineIt = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    const auto lineStart = lineIt == lineStarts_.begin() ? std::size_t{} : *std::prev(lineIt);
+    const auto tabCount = std::lower_bound(tabOffsets_.begin(), tabOffsets_.end(), offset) -
+            std::lower_bound(tabOffsets_.begin(), tabOffsets_.end(), lineStart);
+    return {static_cast<int>(lineIt - lineStarts_.begin()),
+            static_cast<int>(offset - lineStart) + 3 * static_cast<int>(tabCount)};
+}
+
+} //namespace figcone::shoal::detail
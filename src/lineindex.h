@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+struct TextPosition {
+    int line = 0;
+    int column = 0;
+};
+
+// Offsets of line starts and tab characters, used to resolve byte offsets into line and column numbers.
+// The input is indexed in consecutive chunks with extend(), so it's possible to index the data before
+// it's discarded from the stream buffer.
+class LineIndex {
+public:
+    void extend(std::string_view data);
+    std::size_t size() const;
+    // Returns zero based line and column numbers, tabs take 4 columns
+    TextPosition position(std::size_t offset) const;
+
+private:
+    std::vector<std::size_t> lineStarts_;
+    std::vector<std::size_t> tabOffsets_;
+    std::size_t size_ = 0;
+    char lastChar_ = {};
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,169 @@
+#include "listelementreader.h"
+#include "nodeparser.h"
+#include "nodereader.h"
+#include "stream.h"
+#include "structuralindex.h"
+#include "workstealingpool.h"
+#include <figcone_shoal/ieventhandler.h>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+bool isListSeparatorLine(std::string_view data, std::size_t offset)
+{
+    if (data.substr(offset, 3) != "###")
+        return false;
+    for (auto pos = offset; pos > 0; --pos) {
+        const auto ch = data[pos - 1];
+        if (ch == '\n' || ch == '\r')
+            return true;
+        if (ch != ' ' && ch != '\t')
+            return false;
+    }
+    return true;
+}
+
+} //namespace
+
+ListElementReader::ListElementReader(std::string_view data, const StructuralIndex& index, WorkStealingPool& pool)
+    : data_{data}
+    , index_{index}
+    , pool_{pool}
+    , threadStates_(pool.threadCount())
+{
+    for (auto offset = index.next(0); offset < data.size(); offset = index.next(offset + 1)) {
+        if (!isListSeparatorLine(data, offset))
+            continue;
+        elements_.push_back({offset});
+        offset += 2;
+    }
+}
+
+ListElementReader::~ListElementReader() = default;
+
+void ListElementReader::readBatch()
+{
+    const auto batchBegin = elementIndex_;
+    const auto batchEndOffset = elements_[batchBegin].offset + minBatchSize * threadStates_.size();
+    batchEnd_ = batchBegin + 1;
+    while (batchEnd_ < elements_.size() &&
+           (batchEnd_ - batchBegin < threadStates_.size() || elements_[batchEnd_].offset < batchEndOffset))
+        batchEnd_++;
+
+    pool_.run(
+            batchEnd_ - batchBegin,
+            [this, batchBegin](std::size_t threadIndex, std::size_t taskIndex)
+            {
+                readElement(threadStates_[threadIndex], elements_[batchBegin + taskIndex]);
+            });
+}
+
+void ListElementReader::readElement(ThreadState& state, Element& element)
+{
+    // Separators inside the previously read element belong to nested lists
+    if (element.offset > state.lastElementOffset && element.offset < state.lastElementEndOffset)
+        return;
+
+    if (!state.stream) {
+        state.stream = std::make_unique<Stream>(data_);
+        state.stream->setStructuralIndex(index_);
+        // The errors are discarded, the sequential parsing finds them again and reports them with the positions
+        state.stream->disablePositions();
+    }
+    // The reading stopped by an error could leave the stream in the middle of a token
+    auto& stream = *state.stream;
+    stream.seek(element.offset);
+
+    // Empty elements are cheap to read sequentially
+    const auto emptyElementResult = readListElementSeparator(stream, {});
+    if (!emptyElementResult || *emptyElementResult)
+        return;
+
+    const auto eventIndex = state.events.size();
+    const auto valueIndex = state.values.size();
+    const auto contentOffset = stream.offset();
+    auto reader = NodeReader{stream, {}};
+    while (true) {
+        const auto eventType = reader.tryNext();
+        if (!eventType) {
+            state.events.resize(eventIndex);
+            state.values.resize(valueIndex);
+            return;
+        }
+        if (*eventType == ReaderEvent::DocumentEnd)
+            break;
+
+        auto event = Event{*eventType, reader.eventOffset(), reader.name(), state.values.size(), 0};
+        if (event.type == ReaderEvent::Param || event.type == ReaderEvent::ParamList) {
+            const auto& valueList = reader.param().valueList;
+            event.valueCount = valueList.size();
+            state.values.insert(state.values.end(), valueList.begin(), valueList.end());
+        }
+        state.events.push_back(event);
+    }
+    element.threadIndex = static_cast<std::size_t>(&state - threadStates_.data());
+    element.contentOffset = contentOffset;
+    element.endOffset = stream.offset();
+    element.readResult = reader.readResult();
+    element.eventIndex = eventIndex;
+    element.eventCount = state.events.size() - eventIndex;
+    element.isRead = true;
+    state.lastElementOffset = element.offset;
+    state.lastElementEndOffset = element.endOffset;
+}
+
+std::optional<ConfigReadResult> ListElementReader::read(Stream& stream, IEventHandler& handler)
+{
+    const auto offset = stream.offset();
+    while (elementIndex_ < elements_.size() && elements_[elementIndex_].offset < offset)
+        elementIndex_++;
+    if (elementIndex_ == elements_.size() || elements_[elementIndex_].offset != offset)
+        return std::nullopt;
+
+    if (elementIndex_ >= batchEnd_)
+        readBatch();
+    const auto& element = elements_[elementIndex_++];
+    if (!element.isRead)
+        return std::nullopt;
+
+    const auto& state = threadStates_[element.threadIndex];
+    handler.onListElement(stream.position(element.contentOffset));
+    for (auto i = element.eventIndex; i < element.eventIndex + element.eventCount; ++i) {
+        const auto& event = state.events[i];
+        switch (event.type) {
+        case ReaderEvent::NodeBegin:
+            handler.onNodeBegin(stream.intern(event.name), stream.position(event.offset));
+            break;
+        case ReaderEvent::NodeListBegin:
+            handler.onNodeListBegin(stream.intern(event.name), stream.position(event.offset));
+            break;
+        case ReaderEvent::ListElement:
+            handler.onListElement(stream.position(event.offset));
+            break;
+        case ReaderEvent::Param:
+            handler.onParam(
+                    stream.intern(event.name),
+                    stream.intern(state.values[event.valueIndex]),
+                    ParamPosition{stream, event.offset});
+            break;
+        case ReaderEvent::ParamList: {
+            auto valueList = std::vector<std::string_view>{};
+            for (auto j = event.valueIndex; j < event.valueIndex + event.valueCount; ++j)
+                valueList.push_back(stream.intern(state.values[j]));
+            handler.onParamList(stream.intern(event.name), valueList, ParamPosition{stream, event.offset});
+            break;
+        }
+        case ReaderEvent::NodeEnd:
+            handler.onNodeEnd();
+            break;
+        default:
+            break;
+        }
+    }
+    handler.onNodeEnd();
+    stream.skipTo(element.endOffset);
+    return element.readResult;
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,83 @@
+#pragma once
+#include "configreadresult.h"
+#include <figcone_shoal/shoalreader.h>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal {
+class IEventHandler;
+}
+
+namespace figcone::shoal::detail {
+class Stream;
+class StructuralIndex;
+class WorkStealingPool;
+
+// Reads the elements of the node lists of the in-memory input on several threads, ahead of the sequential parsing.
+// Every line starting with the '###' separator is speculatively assumed to begin an element. The element's content
+// doesn't depend on the enclosing nodes, so the events read for an element are replayed only when the sequential
+// parsing reaches the separator at the same offset. The elements are read in batches when the sequential parsing
+// reaches the first one, so nothing is read after it has failed. The elements failed to be read are left to the
+// sequential parsing, so the earliest error in the source order is reported as without the parallel reading.
+class ListElementReader {
+    struct Event {
+        ReaderEvent type;
+        std::size_t offset;
+        std::string_view name;
+        std::size_t valueIndex;
+        std::size_t valueCount;
+    };
+
+    struct Element {
+        std::size_t offset;
+        bool isRead = false;
+        std::size_t threadIndex = 0;
+        std::size_t contentOffset = 0;
+        std::size_t endOffset = 0;
+        ConfigReadResult readResult = {ConfigReadResult::NextAction::ContinueReading, {}, {}};
+        std::size_t eventIndex = 0;
+        std::size_t eventCount = 0;
+    };
+
+    struct ThreadState {
+        std::unique_ptr<Stream> stream;
+        std::vector<Event> events;
+        std::vector<std::string_view> values;
+        std::size_t lastElementOffset = 0;
+        std::size_t lastElementEndOffset = 0;
+    };
+
+public:
+    static constexpr auto minInputSize = std::size_t{512 * 1024};
+    // Size of the input a thread reads in a batch, unless the batch has fewer elements than the threads
+    static constexpr auto minBatchSize = std::size_t{256 * 1024};
+
+    ListElementReader(std::string_view data, const StructuralIndex& index, WorkStealingPool& pool);
+    ~ListElementReader();
+    ListElementReader(const ListElementReader&) = delete;
+    ListElementReader& operator=(const ListElementReader&) = delete;
+
+    // Replays the events of the list element which separator is at the current stream offset if it was read,
+    // and returns the result its reading has finished with.
+    // The elements must be requested in the order of their offsets.
+    std::optional<ConfigReadResult> read(Stream& stream, IEventHandler& handler);
+
+private:
+    void readBatch();
+    void readElement(ThreadState& state, Element& element);
+
+private:
+    std::string_view data_;
+    const StructuralIndex& index_;
+    WorkStealingPool& pool_;
+    std::vector<Element> elements_;
+    std::vector<ThreadState> threadStates_;
+    std::size_t elementIndex_ = 0;
+    // Index of the first element that isn't read yet
+    std::size_t batchEnd_ = 0;
+};
+
+} //namespace figcone::shoal::detail
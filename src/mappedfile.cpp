@@ -0,0 +1,125 @@
+#include "mappedfile.h"
+#include <figcone_tree/errors.h>
+#include <gsl/util>
+#include <limits>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace figcone::shoal::detail {
+
+namespace {
+ConfigError openError(const std::filesystem::path& path)
+{
+    return ConfigError{"Can't open config file '" + path.string() + "' for reading"};
+}
+} //namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto file = CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw openError(path);
+    const auto fileGuard = gsl::finally(
+            [file]
+            {
+                CloseHandle(file);
+            });
+
+    auto fileSize = LARGE_INTEGER{};
+    if (!GetFileSizeEx(file, &fileSize))
+        throw openError(path);
+    if (fileSize.QuadPart == 0)
+        return;
+    if (static_cast<unsigned long long>(fileSize.QuadPart) > std::numeric_limits<std::size_t>::max())
+        throw ConfigError{"Config file '" + path.string() + "' is too large to be mapped into memory"};
+
+    fileMapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!fileMapping_)
+        throw openError(path);
+
+    const auto view = MapViewOfFile(fileMapping_, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(fileMapping_);
+        throw openError(path);
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (fileMapping_)
+        CloseHandle(fileMapping_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1)
+        throw openError(path);
+    const auto fileGuard = gsl::finally(
+            [file]
+            {
+                ::close(file);
+            });
+
+    struct stat fileStat = {};
+    if (::fstat(file, &fileStat) == -1 || !S_ISREG(fileStat.st_mode))
+        throw openError(path);
+    if (fileStat.st_size == 0)
+        return;
+    if (static_cast<unsigned long long>(fileStat.st_size) > std::numeric_limits<std::size_t>::max())
+        throw ConfigError{"Config file '" + path.string() + "' is too large to be mapped into memory"};
+
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    const auto view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED)
+        throw openError(path);
+    // The parser reads the file front to back exactly once
+    ::madvise(view, size, MADV_SEQUENTIAL);
+    ::madvise(view, size, MADV_WILLNEED);
+    data_ = static_cast<const char*>(view);
+    size_ = size;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+}
+
+#endif
+
+std::string_view MappedFile::data() const
+{
+    return {data_, size_};
+}
+
+} //namespace figcone::shoal::detail
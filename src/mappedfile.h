@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace figcone::shoal::detail {
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    std::string_view data() const;
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* fileMapping_ = nullptr;
+#endif
+};
+
+} //namespace figcone::shoal::detail
@@ -1,189 +1,395 @@
 #include "nodeparser.h"
+#include "chunkparamreader.h"
+#include "listelementreader.h"
 #include "paramparser.h"
 #include "stream.h"
 #include "utils.h"
-#include <figcone_tree/errors.h>
-#include <figcone_tree/tree.h>
+#include <figcone_shoal/ieventhandler.h>
+#include <sfun/string_utils.h>
 #include <gsl/assert>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace figcone::shoal::detail {
 
-std::string readNodeName(Stream& stream)
+OpenNode::OpenNode(Arena& arena, bool isRoot, bool isList)
+    : isRoot{isRoot}
+    , isList{isList}
+    , childNodeNames{ArenaAllocator<std::string_view>{arena}}
 {
-    const auto firstChar = stream.read();
-    Expects(firstChar == "#");
-
-    auto nodeName = std::string{};
-    while (!stream.atEnd()) {
-        if (stream.peek() == "\n")
-            throw ConfigError{"Config node can't have a multiline name", stream.position()};
-
-        if (stream.peek() == ":") {
-            stream.skip(1);
-            const auto pos = stream.position();
-            if (!isBlank(readUntil(stream, "\n")))
-                throw ConfigError{
-                        "Wrong config node '" + nodeName +
-                                "' format: only whitespaces and comments can be placed "
-                                "on the same line with config node's name.",
-                        pos};
-            break;
-        }
-        nodeName += stream.read();
+}
+
+Expected<std::string_view> readNodeName(Stream& stream)
+{
+    const auto firstChar = stream.readChar();
+    Expects(firstChar == '#');
+
+    const auto nodeName = stream.intern(readUntil(stream, "\n:"));
+    if (stream.peekChar() == '\n')
+        return ParseError{"Config node can't have a multiline name", stream.position()};
+
+    if (stream.peekChar() == ':') {
+        stream.skip(1);
+        const auto offset = stream.offset();
+        if (!isBlank(readUntil(stream, "\n")))
+            return ParseError{
+                    "Wrong config node '" + std::string{nodeName} +
+                            "' format: only whitespaces and comments can be placed "
+                            "on the same line with config node's name.",
+                    stream.position(offset)};
     }
     return nodeName;
 }
 
-ConfigReadResult readEndToken(Stream& stream)
+Expected<ConfigReadResult> readEndToken(Stream& stream)
 {
     stream.skip(1);
-    if (stream.atEnd() || std::isspace(stream.peek().front()))
-        return {ConfigReadResult::NextAction::ReturnToParentNode, {}, {}};
+    if (stream.atEnd() || sfun::isspace(stream.peekChar()))
+        return ConfigReadResult{ConfigReadResult::NextAction::ReturnToParentNode, {}, {}};
 
-    if (stream.peek(2) == "--") {
+    if (stream.peekMatches("--")) {
         stream.skip(2);
-        if (!stream.peek().empty() && !std::isspace(stream.peek().front()))
-            throw ConfigError{"Invalid closing token '---" + stream.peek() + "'", stream.position()};
+        if (!stream.atEnd() && !sfun::isspace(stream.peekChar()))
+            return ParseError{
+                    "Invalid closing token '---" + std::string(1, stream.peekChar()) + "'",
+                    stream.position()};
 
-        return {ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
+        return ConfigReadResult{ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
     }
 
-    const auto pos = stream.position();
-    const auto nextChar = stream.read();
-    if (nextChar != "-")
-        throw ConfigError{"Invalid closing token '-" + nextChar + "'", pos};
+    const auto offset = stream.offset();
+    const auto nextChar = stream.readChar();
+    if (nextChar != '-')
+        return ParseError{"Invalid closing token '-" + std::string(1, nextChar) + "'", stream.position(offset)};
 
     const auto parentConfigNode = readWord(stream);
-    return {ConfigReadResult::NextAction::ReturnToNodeByName, parentConfigNode, pos};
+    return ConfigReadResult{ConfigReadResult::NextAction::ReturnToNodeByName, parentConfigNode, offset};
 }
 
-ConfigReadResult checkReadResult(
+Expected<ConfigReadResult> checkReadResult(
+        Stream& stream,
         const ConfigReadResult& readResult,
-        const std::string& newNodeName,
-        const figcone::TreeNode& parentNode)
+        std::string_view newNodeName,
+        const OpenNode& parentNode)
 {
     if (readResult.nextAction == ConfigReadResult::NextAction::ReturnToRootNode)
-        return parentNode.isRoot() ? ConfigReadResult{ConfigReadResult::NextAction::ContinueReading, {}, {}}
+        return parentNode.isRoot ? ConfigReadResult{ConfigReadResult::NextAction::ContinueReading, {}, {}}
                                    : readResult;
 
-    if (readResult.nextAction == ConfigReadResult::NextAction::ReturnToParentNode && parentNode.isList()) {
-        if (parentNode.isRoot())
-            throw ConfigError{"Can't close root node", readResult.returnToNodeStreamPosition};
+    const auto returnToNodePosition = [&]
+    {
+        return readResult.returnToNodeOffset ? stream.position(*readResult.returnToNodeOffset) : StreamPosition{};
+    };
+
+    if (readResult.nextAction == ConfigReadResult::NextAction::ReturnToParentNode && parentNode.isList) {
+        if (parentNode.isRoot)
+            return ParseError{"Can't close root node", returnToNodePosition()};
         else
             return readResult;
     }
 
     if (readResult.nextAction == ConfigReadResult::NextAction::ReturnToNodeByName) {
         if (newNodeName != readResult.parentNodeName) {
-            if (parentNode.isRoot())
-                throw ConfigError{
-                        "Can't close unexisting node '" + readResult.parentNodeName + "'",
-                        readResult.returnToNodeStreamPosition};
+            if (parentNode.isRoot)
+                return ParseError{
+                        "Can't close unexisting node '" + std::string{readResult.parentNodeName} + "'",
+                        returnToNodePosition()};
             else
                 return readResult;
         }
-        else if (parentNode.isList())
-            return {ConfigReadResult::NextAction::ReturnToParentNode, {}, {}};
+        else if (parentNode.isList)
+            return ConfigReadResult{ConfigReadResult::NextAction::ReturnToParentNode, {}, {}};
     }
-    return {ConfigReadResult::NextAction::ContinueReading, {}, {}};
+    return ConfigReadResult{ConfigReadResult::NextAction::ContinueReading, {}, {}};
 }
 
-std::optional<ConfigReadResult> parseListElementNodeSection(
+Expected<std::optional<ConfigReadResult>> checkNodeSectionResult(
         Stream& stream,
-        figcone::TreeNode& parent,
-        const std::string& parentName)
+        const ConfigReadResult& readResult,
+        std::string_view nodeName,
+        const OpenNode& parentNode)
 {
-    if (!parent.isList())
-        return ConfigReadResult{ConfigReadResult::NextAction::ContinueReading, {}, {}};
+    auto result = checkReadResult(stream, readResult, nodeName, parentNode);
+    if (!result)
+        return result.error();
+    if (result->nextAction != ConfigReadResult::NextAction::ContinueReading) {
+        if (result->nextAction == ConfigReadResult::NextAction::ReturnToParentNode)
+            result->nextAction = ConfigReadResult::NextAction::ContinueReading;
+        return *result;
+    }
+    return std::nullopt;
+}
 
+Expected<std::optional<ConfigReadResult>> readListElementSeparator(
+        Stream& stream,
+        std::string_view listName,
+        std::size_t* endTokenOffset)
+{
     stream.skip(3);
     skipWhitespace(stream, false);
+    if (endTokenOffset)
+        *endTokenOffset = stream.offset();
     if (stream.atEnd())
         return ConfigReadResult{ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
 
-    if (stream.peek() != "\n")
-        throw ConfigError{
-                "Wrong config node list '" + parentName +
+    if (stream.peekChar() != '\n')
+        return ParseError{
+                "Wrong config node list '" + std::string{listName} +
                         "' format:"
                         " there can't be anything besides comments and whitespaces "
                         "on the same line with list separator '###'",
                 stream.position()};
 
     skipWhitespace(stream, true);
-    const auto readResult = [&]()->ConfigReadResult{
-        if (stream.atEnd())
-            return {ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
-        else if (stream.peek() == "-")
-            return readEndToken(stream);
-        else {
-            auto& nodeList = parent.asList();
-            auto& newNode = nodeList.emplaceBack(stream.position());
-            return parseNode(stream, newNode, parentName);
-        }
-    }();
-
-    auto result = checkReadResult(readResult, parentName, parent);
-    if (result.nextAction != ConfigReadResult::NextAction::ContinueReading) {
-        if (result.nextAction == ConfigReadResult::NextAction::ReturnToParentNode)
-            result.nextAction = ConfigReadResult::NextAction::ContinueReading;
-        return result;
+    if (endTokenOffset)
+        *endTokenOffset = stream.offset();
+    if (stream.atEnd())
+        return ConfigReadResult{ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
+    else if (stream.peekChar() == '-') {
+        const auto endTokenResult = readEndToken(stream);
+        if (!endTokenResult)
+            return endTokenResult.error();
+        return *endTokenResult;
     }
-    return {};
+    return std::nullopt;
 }
 
-std::optional<ConfigReadResult> parseNodeSection(Stream& stream, figcone::TreeNode& parent)
+Expected<NodeHeader> readNodeHeader(Stream& stream, OpenNode& parent)
 {
-    const auto pos = stream.position();
-    const auto newNodeName = readNodeName(stream);
-    if (isBlank(newNodeName))
-        throw ConfigError{"Config node name can't be blank", pos};
+    const auto offset = stream.offset();
+    const auto nameResult = readNodeName(stream);
+    if (!nameResult)
+        return nameResult.error();
+    const auto name = *nameResult;
+    if (isBlank(name))
+        return ParseError{"Config node name can't be blank", stream.position(offset)};
     skipWhitespace(stream);
 
-    if (parent.asItem().hasNode(newNodeName))
-        throw ConfigError{"Config node '" + newNodeName + "' already exist", pos};
-    auto& newNode = [&]() -> decltype(auto)
+    if (!parent.childNodeNames.insert(name).second)
+        return ParseError{"Config node '" + std::string{name} + "' already exist", stream.position(offset)};
+
+    return NodeHeader{name, offset, stream.peekMatches("###")};
+}
+
+namespace {
+
+// Parses the document with the open nodes kept on an explicit stack, so the nesting depth isn't limited by the call
+// stack. Open nodes are indexed by name, a '--name' token finds the node it closes without checking every frame.
+class NodeStackParser {
+    struct Frame {
+        OpenNode node;
+        // List elements have the name of their list
+        std::string_view name;
+        // Closest frame below with the same name, it's indexed by the name again after this frame is closed
+        std::optional<std::size_t> sameNameFrameIndex;
+    };
+
+public:
+    explicit NodeStackParser(ParseContext& ctx)
+        : ctx_{ctx}
+        , stream_{ctx.stream}
     {
-        if (stream.peek(3) == "###")
-            return parent.asItem().addNodeList(newNodeName, pos);
-        else
-            return parent.asItem().addNode(newNodeName, pos);
-    }();
+        frames_.push_back({OpenNode{stream_.arena(), true, false}, {}, {}});
+    }
+
+    Expected<void> parse()
+    {
+        while (!stream_.atEnd()) {
+            if (sfun::isspace(stream_.peekChar())) {
+                stream_.skip(1);
+                continue;
+            }
+            const auto result = readNext();
+            if (!result) {
+                if (!ctx_.errors)
+                    return result.error();
+                recover(result.error());
+            }
+            else if (!*result)
+                return {};
+        }
+        closeFramesAbove(0);
+        return {};
+    }
 
-    const auto readResult = parseNode(stream, newNode, newNodeName);
-    auto result = checkReadResult(readResult, newNodeName, parent);
-    if (result.nextAction != ConfigReadResult::NextAction::ContinueReading) {
-        if (result.nextAction == ConfigReadResult::NextAction::ReturnToParentNode)
-            result.nextAction = ConfigReadResult::NextAction::ContinueReading;
-        return result;
+private:
+    // Returns false if the document's reading is finished
+    Expected<bool> readNext()
+    {
+        const auto nextChar = stream_.peekChar();
+        if (stream_.peekMatches("###"))
+            return readListElementStart();
+        if (nextChar == '#')
+            return readNodeStart();
+        if (nextChar == '-') {
+            const auto readResult = readEndToken(stream_);
+            if (!readResult)
+                return readResult.error();
+            return finishTopFrame(*readResult);
+        }
+        return readParamContent();
     }
-    return {};
-}
 
-ConfigReadResult parseNode(Stream& stream, figcone::TreeNode& node, const std::string& nodeName)
-{
-    while (!stream.atEnd()) {
-        const auto nextChar = stream.peek().front();
-        if (std::isspace(nextChar))
-            stream.skip(1);
-        else if (stream.peek(3) == "###") {
-            if (auto res = parseListElementNodeSection(stream, node, nodeName))
-                return *res;
+    Expected<bool> readListElementStart()
+    {
+        auto& frame = frames_.back();
+        if (!frame.node.isList)
+            return finishTopFrame({ConfigReadResult::NextAction::ContinueReading, {}, {}});
+
+        const auto listName = frame.name;
+        if (ctx_.listElementReader)
+            if (auto elementResult = ctx_.listElementReader->read(stream_, ctx_.handler))
+                return unwind(*elementResult, listName);
+
+        const auto emptyElementResult = readListElementSeparator(stream_, listName);
+        if (!emptyElementResult) {
+            if (!ctx_.errors)
+                return emptyElementResult.error();
+            // The element is opened anyway, as the node list can't contain the following content itself
+            recover(emptyElementResult.error());
         }
-        else if (nextChar == '#') {
-            if (auto res = parseNodeSection(stream, node))
-                return *res;
+        else if (*emptyElementResult)
+            return unwind(**emptyElementResult, listName);
+
+        ctx_.handler.onListElement(stream_.position());
+        openFrame(listName, false);
+        return true;
+    }
+
+    Expected<bool> readNodeStart()
+    {
+        const auto header = readNodeHeader(stream_, frames_.back().node);
+        if (!header)
+            return header.error();
+        if (header->isList)
+            ctx_.handler.onNodeListBegin(header->name, stream_.position(header->offset));
+        else
+            ctx_.handler.onNodeBegin(header->name, stream_.position(header->offset));
+        openFrame(header->name, header->isList);
+        return true;
+    }
+
+    Expected<bool> readParamContent()
+    {
+        auto& param = ctx_.param;
+        if (!ctx_.chunkParamReader || !ctx_.chunkParamReader->read(stream_, param))
+            if (const auto result = readParam(stream_, param); !result)
+                return result.error();
+        if (param.isList)
+            ctx_.handler.onParamList(param.name, param.valueList, ParamPosition{stream_, param.offset});
+        else
+            ctx_.handler.onParam(param.name, param.valueList.at(0), ParamPosition{stream_, param.offset});
+        return true;
+    }
+
+    // The top node's reading has finished with the result, returns false if it's the root node
+    Expected<bool> finishTopFrame(const ConfigReadResult& readResult)
+    {
+        if (frames_.size() == 1)
+            return false;
+        const auto name = frames_.back().name;
+        closeTopFrame();
+        return unwind(readResult, name);
+    }
+
+    // Closes the nodes that the result of the closed child node's reading requires,
+    // the same way checkNodeSectionResult does it for every frame. Returns false if the document's reading is finished.
+    Expected<bool> unwind(const ConfigReadResult& readResult, std::string_view childName)
+    {
+        using NextAction = ConfigReadResult::NextAction;
+        switch (readResult.nextAction) {
+        case NextAction::ContinueReading:
+            return true;
+        case NextAction::ReturnToParentNode:
+            // '-' closes the list element and its list
+            if (frames_.back().node.isList)
+                return finishTopFrame({NextAction::ContinueReading, {}, {}});
+            return true;
+        case NextAction::ReturnToRootNode:
+            closeFramesAbove(0);
+            return true;
+        case NextAction::ReturnToNodeByName:
+            break;
         }
-        else if (nextChar == '-')
-            return readEndToken(stream);
-        else {
-            const auto [paramName, param] = parseParam(stream);
-            if (param.isItem())
-                node.asItem().addParam(paramName, param.value());
-            else
-                node.asItem().addParamList(paramName, param.valueList());
+
+        if (childName != readResult.parentNodeName) {
+            const auto it = openFrameIndices_.find(readResult.parentNodeName);
+            if (it == openFrameIndices_.end()) {
+                auto error = ParseError{
+                        "Can't close unexisting node '" + std::string{readResult.parentNodeName} + "'",
+                        readResult.returnToNodeOffset ? stream_.position(*readResult.returnToNodeOffset)
+                                                      : StreamPosition{}};
+                if (!ctx_.errors) {
+                    closeFramesAbove(0);
+                    return error;
+                }
+                // With the error recovery, the token closes the node like '-'
+                ctx_.errors->push_back(std::move(error));
+                return unwind({NextAction::ReturnToParentNode, {}, {}}, childName);
+            }
+            closeFramesAbove(it->second - 1);
         }
+        // '--name' of the list element closes its list too
+        if (frames_.back().node.isList)
+            return finishTopFrame({NextAction::ContinueReading, {}, {}});
+        return true;
     }
-    return {ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
+
+    // Skips the rest of the line with the error, the following lines are read as if it wasn't there
+    void recover(const ParseError& error)
+    {
+        ctx_.errors->push_back(error);
+        skipLine(stream_);
+    }
+
+    void openFrame(std::string_view name, bool isList)
+    {
+        auto [it, isInserted] = openFrameIndices_.try_emplace(name, frames_.size());
+        auto sameNameFrameIndex = std::optional<std::size_t>{};
+        if (!isInserted)
+            sameNameFrameIndex = std::exchange(it->second, frames_.size());
+        frames_.push_back({OpenNode{stream_.arena(), false, isList}, name, sameNameFrameIndex});
+    }
+
+    void closeTopFrame()
+    {
+        Expects(frames_.size() > 1);
+        const auto& frame = frames_.back();
+        if (frame.sameNameFrameIndex)
+            openFrameIndices_[frame.name] = *frame.sameNameFrameIndex;
+        else
+            openFrameIndices_.erase(frame.name);
+        frames_.pop_back();
+        ctx_.handler.onNodeEnd();
+    }
+
+    void closeFramesAbove(std::size_t frameIndex)
+    {
+        while (frames_.size() > frameIndex + 1)
+            closeTopFrame();
+    }
+
+private:
+    ParseContext& ctx_;
+    Stream& stream_;
+    std::vector<Frame> frames_;
+    // Index of the topmost open frame with the name, the root node isn't indexed
+    std::unordered_map<std::string_view, std::size_t> openFrameIndices_;
+};
+
+} //namespace
+
+Expected<void> parseRootNode(
+        Stream& stream,
+        IEventHandler& handler,
+        ChunkParamReader* chunkParamReader,
+        ListElementReader* listElementReader,
+        std::vector<ParseError>* errors)
+{
+    auto ctx = ParseContext{stream, handler, {}, chunkParamReader, listElementReader, errors};
+    auto parser = NodeStackParser{ctx};
+    return parser.parse();
 }
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
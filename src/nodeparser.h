@@ -1,26 +1,83 @@
 #pragma once
+#include "arena.h"
 #include "configreadresult.h"
+#include "paramparser.h"
+#include <figcone_shoal/parseresult.h>
+#include <cstddef>
+#include <functional>
 #include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
-namespace figcone {
-class TreeNode;
+namespace figcone::shoal {
+class IEventHandler;
 }
 
 namespace figcone::shoal::detail {
 class Stream;
+class ChunkParamReader;
+class ListElementReader;
 
-std::string readNodeName(Stream& stream);
-ConfigReadResult readEndToken(Stream& stream);
-ConfigReadResult checkReadResult(
+struct ParseContext {
+    Stream& stream;
+    IEventHandler& handler;
+    ParamData param;
+    ChunkParamReader* chunkParamReader = nullptr;
+    ListElementReader* listElementReader = nullptr;
+    // Enables the error recovery, the errors are collected here and the parsing resumes at the next line
+    std::vector<ParseError>* errors = nullptr;
+};
+
+// Node that is currently being read, the tree itself is built by the event handler
+struct OpenNode {
+    OpenNode(Arena& arena, bool isRoot, bool isList);
+
+    bool isRoot;
+    bool isList;
+    std::unordered_set<
+            std::string_view,
+            std::hash<std::string_view>,
+            std::equal_to<std::string_view>,
+            ArenaAllocator<std::string_view>>
+            childNodeNames;
+};
+
+struct NodeHeader {
+    std::string_view name;
+    std::size_t offset;
+    bool isList;
+};
+
+// Syntax errors are returned instead of being thrown, ConfigError is thrown only by the readers using these functions
+Expected<std::string_view> readNodeName(Stream& stream);
+// Reads the node name line and registers the name in the parent node
+Expected<NodeHeader> readNodeHeader(Stream& stream, OpenNode& parent);
+Expected<ConfigReadResult> readEndToken(Stream& stream);
+Expected<ConfigReadResult> checkReadResult(
+        Stream& stream,
         const ConfigReadResult& readResult,
-        const std::string& newNodeName,
-        const figcone::TreeNode& parentNode);
-std::optional<ConfigReadResult> parseListElementNodeSection(
+        std::string_view newNodeName,
+        const OpenNode& parentNode);
+// Returns the result the parent node's reading finishes with, or nothing if it continues
+Expected<std::optional<ConfigReadResult>> checkNodeSectionResult(
         Stream& stream,
-        figcone::TreeNode& parent,
-        const std::string& parentName);
-
-std::optional<ConfigReadResult> parseNodeSection(Stream& stream, figcone::TreeNode& parent);
-ConfigReadResult parseNode(Stream& stream, figcone::TreeNode& node, const std::string& nodeName);
+        const ConfigReadResult& readResult,
+        std::string_view nodeName,
+        const OpenNode& parentNode);
+// Reads the '###' separator, returns the read result if the list element has no content.
+// The offset of the token that has finished the empty element's reading is stored in endTokenOffset.
+Expected<std::optional<ConfigReadResult>> readListElementSeparator(
+        Stream& stream,
+        std::string_view listName,
+        std::size_t* endTokenOffset = nullptr);
+// Parses the document with an explicit stack of the open nodes, so the nesting depth is limited only by the memory.
+// When errors is set, the errors are collected there and an error is never returned.
+Expected<void> parseRootNode(
+        Stream& stream,
+        IEventHandler& handler,
+        ChunkParamReader* chunkParamReader = nullptr,
+        ListElementReader* listElementReader = nullptr,
+        std::vector<ParseError>* errors = nullptr);
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
@@ -0,0 +1,154 @@
+#include "nodereader.h"
+#include "stream.h"
+#include "utils.h"
+#include <sfun/string_utils.h>
+#include <gsl/assert>
+
+namespace figcone::shoal::detail {
+
+NodeReader::NodeReader(Stream& stream)
+    : stream_{stream}
+{
+    frames_.push_back({OpenNode{stream_.arena(), true, false}, {}});
+}
+
+NodeReader::NodeReader(Stream& stream, std::string_view nodeName, bool isList)
+    : stream_{stream}
+{
+    frames_.push_back({OpenNode{stream_.arena(), false, isList}, nodeName});
+}
+
+ReaderEvent NodeReader::next()
+{
+    return valueOrThrow(tryNext());
+}
+
+Expected<ReaderEvent> NodeReader::tryNext()
+{
+    if (event_ == ReaderEvent::DocumentEnd)
+        return event_;
+
+    while (true) {
+        if (childResult_) {
+            const auto [readResult, childName] = *childResult_;
+            childResult_.reset();
+            const auto nodeResult = checkNodeSectionResult(stream_, readResult, childName, frames_.back().node);
+            if (!nodeResult)
+                return nodeResult.error();
+            nodeResult_ = *nodeResult;
+        }
+
+        if (nodeResult_) {
+            readResult_ = *nodeResult_;
+            if (frames_.size() == 1) {
+                nodeResult_.reset();
+                return setEvent(ReaderEvent::DocumentEnd, {}, stream_.offset());
+            }
+            childResult_.emplace(*nodeResult_, frames_.back().name);
+            nodeResult_.reset();
+            frames_.pop_back();
+            return setEvent(ReaderEvent::NodeEnd, {}, nodeEndOffset_);
+        }
+
+        const auto event = readNodeContent();
+        if (!event || *event != ReaderEvent::None)
+            return event;
+    }
+}
+
+Expected<ReaderEvent> NodeReader::readNodeContent()
+{
+    auto& [node, nodeName] = frames_.back();
+    while (!stream_.atEnd()) {
+        const auto nextChar = stream_.peekChar();
+        if (sfun::isspace(nextChar))
+            stream_.skip(1);
+        else if (stream_.peekMatches("###")) {
+            if (!node.isList) {
+                nodeEndOffset_ = stream_.offset();
+                nodeResult_ = ConfigReadResult{ConfigReadResult::NextAction::ContinueReading, {}, {}};
+                return ReaderEvent::None;
+            }
+            const auto listName = nodeName;
+            // The closing token of an empty element finishes the reading of the nodes it returns from
+            const auto emptyElementResult = readListElementSeparator(stream_, listName, &nodeEndOffset_);
+            if (!emptyElementResult)
+                return emptyElementResult.error();
+            if (*emptyElementResult) {
+                childResult_.emplace(**emptyElementResult, listName);
+                return ReaderEvent::None;
+            }
+            const auto offset = stream_.offset();
+            frames_.push_back({OpenNode{stream_.arena(), false, false}, listName});
+            return setEvent(ReaderEvent::ListElement, listName, offset);
+        }
+        else if (nextChar == '#') {
+            const auto header = readNodeHeader(stream_, node);
+            if (!header)
+                return header.error();
+            frames_.push_back({OpenNode{stream_.arena(), false, header->isList}, header->name});
+            return setEvent(
+                    header->isList ? ReaderEvent::NodeListBegin : ReaderEvent::NodeBegin,
+                    header->name,
+                    header->offset);
+        }
+        else if (nextChar == '-') {
+            nodeEndOffset_ = stream_.offset();
+            const auto endTokenResult = readEndToken(stream_);
+            if (!endTokenResult)
+                return endTokenResult.error();
+            nodeResult_ = *endTokenResult;
+            return ReaderEvent::None;
+        }
+        else {
+            if (const auto result = readParam(stream_, param_); !result)
+                return result.error();
+            return setEvent(param_.isList ? ReaderEvent::ParamList : ReaderEvent::Param, param_.name, param_.offset);
+        }
+    }
+    nodeEndOffset_ = stream_.offset();
+    nodeResult_ = ConfigReadResult{ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
+    return ReaderEvent::None;
+}
+
+ReaderEvent NodeReader::setEvent(ReaderEvent event, std::string_view name, std::size_t offset)
+{
+    event_ = event;
+    eventName_ = name;
+    eventOffset_ = offset;
+    return event_;
+}
+
+ReaderEvent NodeReader::event() const
+{
+    return event_;
+}
+
+std::string_view NodeReader::name() const
+{
+    return eventName_;
+}
+
+const ParamData& NodeReader::param() const
+{
+    Expects(event_ == ReaderEvent::Param || event_ == ReaderEvent::ParamList);
+    return param_;
+}
+
+std::size_t NodeReader::eventOffset() const
+{
+    return eventOffset_;
+}
+
+std::size_t NodeReader::depth() const
+{
+    return frames_.size() - 1;
+}
+
+const ConfigReadResult& NodeReader::readResult() const
+{
+    Expects(event_ == ReaderEvent::NodeEnd || event_ == ReaderEvent::DocumentEnd);
+    return readResult_;
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,59 @@
+#pragma once
+#include "configreadresult.h"
+#include "nodeparser.h"
+#include "paramparser.h"
+#include <figcone_shoal/shoalreader.h>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace figcone::shoal::detail {
+class Stream;
+
+// Reads the document event by event, keeping the open nodes on an explicit stack like parseRootNode does
+class NodeReader {
+    struct Frame {
+        OpenNode node;
+        std::string_view name;
+    };
+
+public:
+    explicit NodeReader(Stream& stream);
+    // Reads the content of the node or the list element starting at the stream offset, the end of the node
+    // is reported as DocumentEnd. List elements have the name of their list.
+    NodeReader(Stream& stream, std::string_view nodeName, bool isList = false);
+    ReaderEvent next();
+    // Returns the syntax error instead of throwing ConfigError, the reading can't be continued after it
+    Expected<ReaderEvent> tryNext();
+
+    ReaderEvent event() const;
+    std::string_view name() const;
+    const ParamData& param() const;
+    std::size_t eventOffset() const;
+    std::size_t depth() const;
+    // Result the reading of the node has finished with, available after NodeEnd and DocumentEnd
+    const ConfigReadResult& readResult() const;
+
+private:
+    Expected<ReaderEvent> readNodeContent();
+    ReaderEvent setEvent(ReaderEvent event, std::string_view name, std::size_t offset);
+
+private:
+    Stream& stream_;
+    std::vector<Frame> frames_;
+    ParamData param_;
+    ReaderEvent event_ = ReaderEvent::None;
+    std::string_view eventName_;
+    std::size_t eventOffset_ = 0;
+    // Result the top node's reading has finished with
+    std::optional<ConfigReadResult> nodeResult_;
+    // Result the last closed child node's reading has finished with, and its name
+    std::optional<std::pair<ConfigReadResult, std::string_view>> childResult_;
+    // Offset of the token that has finished the top node's reading, NodeEnd events are reported at it
+    std::size_t nodeEndOffset_ = 0;
+    ConfigReadResult readResult_ = {ConfigReadResult::NextAction::ReturnToRootNode, {}, {}};
+};
+
+} //namespace figcone::shoal::detail
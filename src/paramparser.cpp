@@ -1,30 +1,33 @@
 #include "paramparser.h"
+#include "charscan.h"
+#include "charset.h"
 #include "stream.h"
 #include "utils.h"
-#include <figcone_tree/errors.h>
-#include <sfun/string_utils.h>
 #include <gsl/util>
 #include <optional>
+#include <string_view>
 #include <utility>
 
 namespace figcone::shoal::detail {
 
 namespace {
 
-void skipParamWhitespace(Stream& stream, const std::string& paramName)
+Expected<void> skipParamWhitespace(Stream& stream, std::string_view paramName)
 {
     skipWhitespace(stream, false);
-    if (stream.peek() == "\n")
-        throw ConfigError{
-                "Wrong param '" + paramName + "' format: parameter's value must be placed on the same line as its name",
+    if (stream.peekChar() == '\n')
+        return ParseError{
+                "Wrong param '" + std::string{paramName} +
+                        "' format: parameter's value must be placed on the same line as its name",
                 stream.position()};
+    return {};
 }
 
-std::optional<std::string> readSingleParam(
+Expected<std::optional<std::string_view>> readSingleParam(
         Stream& stream,
-        const std::string& wordSeparator,
-        const std::vector<std::string>& paramListValue,
-        const std::string& paramName,
+        std::string_view stopChars,
+        const std::vector<std::string_view>& paramListValue,
+        std::string_view paramName,
         bool isMultiline)
 {
     if (isMultiline)
@@ -36,100 +39,215 @@ std::optional<std::string> readSingleParam(
                     stream.skipComments(true);
             });
 
-    if (const auto quotedParam = readQuotedString(stream))
-        return *quotedParam;
+    const auto quotedParam = readQuotedString(stream);
+    if (!quotedParam)
+        return quotedParam.error();
+    if (*quotedParam)
+        return stream.intern(**quotedParam);
     else {
-        auto result = sfun::trim(readUntil(stream, wordSeparator + "\n"));
+        const auto result = stream.intern(trim(readUntil(stream, stopChars)));
         if (result.empty()) {
-            if (stream.peek() == "," || (paramListValue.empty() && !isMultiline))
-                throw ConfigError{"Parameter list '" + paramName + "' element is missing", stream.position()};
+            if (stream.peekChar() == ',' || (paramListValue.empty() && !isMultiline))
+                return ParseError{
+                        "Parameter list '" + std::string{paramName} + "' element is missing",
+                        stream.position()};
             if (paramListValue.empty() && isMultiline)
-                return {};
+                return std::nullopt;
         }
         return result;
     }
 }
 
-figcone::TreeParam makeParam(
-        const std::vector<std::string>& paramValueList,
-        const StreamPosition& position,
-        bool isList)
+Expected<void> readParamOrParamList(Stream& stream, ParamData& param, bool isMultiline = false)
 {
-    if (isList)
-        return figcone::TreeParam{paramValueList, position};
-    else
-        return figcone::TreeParam{paramValueList.at(0), position};
-}
-
-figcone::TreeParam readParamOrParamList(
-        Stream& stream,
-        const std::string& paramName,
-        StreamPosition pos,
-        bool isMultiline = false)
-{
-    auto paramValueList = std::vector<std::string>{};
-    auto isList = isMultiline;
+    param.isList = isMultiline;
     while (!stream.atEnd()) {
-        auto paramValue = readSingleParam(stream, isMultiline ? ",]" : ",", paramValueList, paramName, isMultiline);
-        if (paramValue)
-            paramValueList.emplace_back(std::move(*paramValue));
+        const auto paramValue =
+                readSingleParam(stream, isMultiline ? ",]\n" : ",\n", param.valueList, param.name, isMultiline);
+        if (!paramValue)
+            return paramValue.error();
+        if (*paramValue)
+            param.valueList.emplace_back(**paramValue);
 
         skipWhitespace(stream, isMultiline);
-        const auto endOfList = isMultiline ? "]" : "\n";
-        if (stream.peek() == ",") {
-            isList = true;
+        const auto endOfList = isMultiline ? ']' : '\n';
+        if (stream.peekChar() == ',') {
+            param.isList = true;
             stream.skip(1);
             skipWhitespace(stream, isMultiline);
-            if (stream.peek() == endOfList || stream.atEnd())
-                throw ConfigError{"Parameter list '" + paramName + "' element is missing", stream.position()};
+            if (stream.peekChar() == endOfList || stream.atEnd())
+                return ParseError{
+                        "Parameter list '" + std::string{param.name} + "' element is missing",
+                        stream.position()};
         }
-        else if (stream.peek() == endOfList) {
+        else if (stream.peekChar() == endOfList) {
             stream.skip(1);
-            return makeParam(paramValueList, pos, isList);
+            return {};
         }
         else if (stream.atEnd())
-            return makeParam(paramValueList, pos, isList);
+            return {};
         else
-            throw ConfigError{
-                    "Wrong param '" + paramName + "' format: there must be only one parameter per line",
+            return ParseError{
+                    "Wrong param '" + std::string{param.name} + "' format: there must be only one parameter per line",
                     stream.position()};
     }
-    return makeParam(paramValueList, pos, isList);
+    return {};
+}
+
+constexpr auto blankChars = CharSet{" \t\v\f"};
+constexpr auto lineSeparatorChars = CharSet{"\r\n"};
+
+// Reads a param which values are unquoted or quoted on the same line, directly from the in-memory input,
+// using its structural index to find the ends of the name and the values.
+// Returns false without consuming the input when the param needs the complete grammar,
+// including all the cases reported as errors.
+bool readSingleLineParam(Stream& stream, ParamData& param)
+{
+    const auto index = stream.structuralIndex();
+    if (!index)
+        return false;
+
+    const auto data = stream.data();
+    const auto findNext = [&](std::size_t offset, const CharSet& chars)
+    {
+        offset = index->next(offset);
+        while (offset != data.size() && !chars.contains(data[offset]))
+            offset = index->next(offset + 1);
+        return offset;
+    };
+    const auto find = [&](std::size_t offset, std::size_t endOffset, const CharSet& chars, bool isNegated)
+    {
+        const auto first = data.data() + offset;
+        const auto last = data.data() + endOffset;
+        return offset + static_cast<std::size_t>((isNegated ? findFirstNotOf(first, last, chars)
+                                                            : findFirstOf(first, last, chars)) - first);
+    };
+    const auto skipBlanks = [&](std::size_t offset)
+    {
+        return find(offset, data.size(), blankChars, true);
+    };
+    const auto isValueEnd = [&](std::size_t offset)
+    {
+        return offset == data.size() || data[offset] == '\r' || data[offset] == '\n' || data[offset] == ';';
+    };
+
+    const auto nameOffset = stream.offset();
+    const auto assignmentOffset = findNext(nameOffset, CharSet{"\r\n;="});
+    if (assignmentOffset == data.size() || data[assignmentOffset] != '=')
+        return false;
+    const auto nameEndOffset = find(nameOffset, assignmentOffset, blankChars, false);
+    if (nameEndOffset == nameOffset || find(nameEndOffset, assignmentOffset, blankChars, true) != assignmentOffset)
+        return false;
+
+    auto offset = skipBlanks(assignmentOffset + 1);
+    if (isValueEnd(offset) || data[offset] == '[')
+        return false;
+
+    while (true) {
+        const auto ch = data[offset];
+        if (ch == '\'' || ch == '"' || ch == '`') {
+            auto stopChars = lineSeparatorChars;
+            stopChars.add(ch);
+            const auto quoteEndOffset = findNext(offset + 1, stopChars);
+            if (quoteEndOffset == data.size() || data[quoteEndOffset] != ch)
+                return false;
+            param.valueList.emplace_back(data.substr(offset + 1, quoteEndOffset - offset - 1));
+            offset = quoteEndOffset + 1;
+        }
+        else {
+            const auto valueEndOffset = findNext(offset, CharSet{",\r\n;"});
+            const auto value = trim(data.substr(offset, valueEndOffset - offset));
+            if (value.empty())
+                return false;
+            param.valueList.emplace_back(value);
+            offset = valueEndOffset;
+        }
+
+        offset = skipBlanks(offset);
+        if (offset == data.size())
+            break;
+        if (data[offset] == ',') {
+            param.isList = true;
+            offset = skipBlanks(offset + 1);
+            if (isValueEnd(offset))
+                return false;
+            continue;
+        }
+        if (data[offset] == ';') {
+            offset = findNext(offset, lineSeparatorChars);
+            if (offset == data.size())
+                return false;
+        }
+        if (data[offset] == '\r' || data[offset] == '\n') {
+            offset += (data[offset] == '\r' && offset + 1 < data.size() && data[offset + 1] == '\n') ? 2 : 1;
+            break;
+        }
+        return false;
+    }
+
+    param.name = stream.intern(data.substr(nameOffset, nameEndOffset - nameOffset));
+    for (auto& value : param.valueList)
+        value = stream.intern(value);
+    stream.skipTo(offset);
+    return true;
 }
 
-figcone::TreeParam readParamValue(Stream& stream, const std::string& paramName, StreamPosition pos)
+Expected<void> readParamValue(Stream& stream, ParamData& param)
 {
     skipWhitespace(stream, false);
-    if (stream.peek() == "\n" || stream.atEnd())
-        throw ConfigError{"Parameter '" + paramName + "' value is missing", stream.position()};
+    if (stream.peekChar() == '\n' || stream.atEnd())
+        return ParseError{"Parameter '" + std::string{param.name} + "' value is missing", stream.position()};
 
-    if (stream.peek() == "[") {
+    if (stream.peekChar() == '[') {
         stream.skip(1);
         skipWhitespace(stream);
-        return readParamOrParamList(stream, paramName, pos, true);
+        return readParamOrParamList(stream, param, true);
     }
-    else
-        return readParamOrParamList(stream, paramName, pos, false);
+    return readParamOrParamList(stream, param, false);
 }
 
 } //namespace
 
-std::pair<std::string, figcone::TreeParam> parseParam(Stream& stream)
+Expected<void> readParam(Stream& stream, ParamData& param)
 {
+    param.valueList.clear();
+    param.isList = false;
+
     skipWhitespace(stream);
-    const auto paramPos = stream.position();
-    auto paramName = readWord(stream, "=");
-    if (paramName.empty())
-        throw ConfigError{"Parameter's name can't be empty", paramPos};
+    param.offset = stream.offset();
+    if (readSingleLineParam(stream, param))
+        return {};
+    param.valueList.clear();
+    param.isList = false;
+
+    param.name = stream.intern(readWord(stream, "="));
+    if (param.name.empty())
+        return ParseError{"Parameter's name can't be empty", stream.position(param.offset)};
 
-    skipParamWhitespace(stream, paramName);
+    if (auto result = skipParamWhitespace(stream, param.name); !result)
+        return result;
+
+    const auto offset = stream.offset();
+    if (stream.readChar() != '=')
+        return ParseError{
+                "Wrong param '" + std::string{param.name} + "' format: missing '='",
+                stream.position(offset)};
 
-    const auto pos = stream.position();
-    if (stream.read() != "=")
-        throw ConfigError{"Wrong param '" + paramName + "' format: missing '='", pos};
+    if (auto result = skipParamWhitespace(stream, param.name); !result)
+        return result;
+    return readParamValue(stream, param);
+}
 
-    skipParamWhitespace(stream, paramName);
-    return {paramName, readParamValue(stream, paramName, paramPos)};
+std::pair<std::string, figcone::TreeParam> parseParam(Stream& stream)
+{
+    auto param = ParamData{};
+    valueOrThrow(readParam(stream, param));
+    const auto position = stream.position(param.offset);
+    if (param.isList)
+        return {std::string{param.name},
+                figcone::TreeParam{std::vector<std::string>{param.valueList.begin(), param.valueList.end()}, position}};
+    else
+        return {std::string{param.name}, figcone::TreeParam{std::string{param.valueList.at(0)}, position}};
 }
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
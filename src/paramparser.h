@@ -1,9 +1,23 @@
 #pragma once
+#include <figcone_shoal/parseresult.h>
 #include <figcone_tree/tree.h>
+#include <cstddef>
+#include <string_view>
+#include <vector>
 
 namespace figcone::shoal::detail {
 class Stream;
 
+struct ParamData {
+    std::string_view name;
+    std::vector<std::string_view> valueList;
+    bool isList = false;
+    std::size_t offset = 0;
+};
+
+// Reads the next param into param, its value list storage is reused between the calls
+Expected<void> readParam(Stream& stream, ParamData& param);
+// Throws ConfigError on the errors
 std::pair<std::string, figcone::TreeParam> parseParam(Stream& stream);
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
@@ -0,0 +1,22 @@
+#include "stream.h"
+#include <figcone_shoal/paramposition.h>
+
+namespace figcone::shoal {
+
+ParamPosition::ParamPosition(const StreamPosition& position)
+    : position_{position}
+{
+}
+
+ParamPosition::ParamPosition(detail::Stream& stream, std::size_t offset)
+    : stream_{&stream}
+    , offset_{offset}
+{
+}
+
+StreamPosition ParamPosition::resolve() const
+{
+    return stream_ ? stream_->position(offset_) : position_;
+}
+
+} //namespace figcone::shoal
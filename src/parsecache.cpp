@@ -0,0 +1,347 @@
+#include "parsecache.h"
+#include "mappedfile.h"
+#include <figcone_tree/errors.h>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+constexpr auto entryFormat = std::string_view{"figcone_shoal parse cache v1\n"};
+
+enum class EventType : char {
+    NodeBegin = 1,
+    NodeListBegin,
+    ListElement,
+    Param,
+    ParamList,
+    NodeEnd
+};
+
+std::uint64_t hashData(std::string_view data)
+{
+    // FNV-1a applied to 8 byte words, as it only needs to detect the changes of the file
+    constexpr auto prime = std::uint64_t{0x100000001b3};
+    auto hash = std::uint64_t{0xcbf29ce484222325} ^ data.size();
+    auto pos = std::size_t{};
+    for (; pos + sizeof(std::uint64_t) <= data.size(); pos += sizeof(std::uint64_t)) {
+        auto word = std::uint64_t{};
+        std::memcpy(&word, data.data() + pos, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for (; pos < data.size(); ++pos)
+        hash = (hash ^ static_cast<unsigned char>(data[pos])) * prime;
+    return hash;
+}
+
+template<typename T>
+void writeValue(std::string& data, T value)
+{
+    data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeValue(std::string& data, std::string_view str)
+{
+    writeValue(data, static_cast<std::uint32_t>(str.size()));
+    data.append(str);
+}
+
+void writeValue(std::string& data, const StreamPosition& position)
+{
+    writeValue(data, static_cast<std::int32_t>(position.line.value_or(-1)));
+    writeValue(data, static_cast<std::int32_t>(position.column.value_or(-1)));
+}
+
+class EventReader {
+public:
+    explicit EventReader(std::string_view data)
+        : data_{data}
+    {
+    }
+
+    bool atEnd() const
+    {
+        return pos_ == data_.size();
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+        if (data_.size() - pos_ < sizeof(T))
+            return false;
+        std::memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool read(std::string_view& str)
+    {
+        auto size = std::uint32_t{};
+        if (!read(size) || data_.size() - pos_ < size)
+            return false;
+        str = data_.substr(pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool read(StreamPosition& position)
+    {
+        auto line = std::int32_t{};
+        auto column = std::int32_t{};
+        if (!read(line) || !read(column))
+            return false;
+        position = {};
+        if (line != -1)
+            position.line = line;
+        if (column != -1)
+            position.column = column;
+        return true;
+    }
+
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+};
+
+struct ReplayedNode {
+    bool isList;
+    std::unordered_set<std::string_view> childNodeNames;
+};
+
+// Only validates the events when handler is null.
+// The events must have the structure the parser produces, so the tree builder never gets a list element
+// outside a node list, a param inside it, or nodes with the same name.
+bool replayEvents(std::string_view events, IEventHandler* handler)
+{
+    auto reader = EventReader{events};
+    auto nodeStack = std::vector<ReplayedNode>{};
+    nodeStack.push_back({false, {}});
+    auto name = std::string_view{};
+    auto value = std::string_view{};
+    auto valueList = std::vector<std::string_view>{};
+    auto position = StreamPosition{};
+    while (!reader.atEnd()) {
+        auto type = EventType{};
+        if (!reader.read(type))
+            return false;
+
+        switch (type) {
+        case EventType::NodeBegin:
+        case EventType::NodeListBegin:
+            if (!reader.read(name) || !reader.read(position))
+                return false;
+            if (nodeStack.back().isList || !nodeStack.back().childNodeNames.insert(name).second)
+                return false;
+            nodeStack.push_back({type == EventType::NodeListBegin, {}});
+            if (handler && type == EventType::NodeBegin)
+                handler->onNodeBegin(name, position);
+            else if (handler)
+                handler->onNodeListBegin(name, position);
+            break;
+        case EventType::ListElement:
+            if (!reader.read(position))
+                return false;
+            if (!nodeStack.back().isList)
+                return false;
+            nodeStack.push_back({false, {}});
+            if (handler)
+                handler->onListElement(position);
+            break;
+        case EventType::Param:
+            if (!reader.read(name) || !reader.read(value) || !reader.read(position))
+                return false;
+            if (nodeStack.back().isList)
+                return false;
+            if (handler)
+                handler->onParam(name, value, position);
+            break;
+        case EventType::ParamList: {
+            auto valueCount = std::uint32_t{};
+            if (!reader.read(name) || !reader.read(valueCount))
+                return false;
+            valueList.clear();
+            for (auto i = std::uint32_t{}; i < valueCount; ++i) {
+                if (!reader.read(value))
+                    return false;
+                valueList.push_back(value);
+            }
+            if (!reader.read(position))
+                return false;
+            if (nodeStack.back().isList)
+                return false;
+            if (handler)
+                handler->onParamList(name, valueList, position);
+            break;
+        }
+        case EventType::NodeEnd:
+            if (nodeStack.size() == 1)
+                return false;
+            nodeStack.pop_back();
+            if (handler)
+                handler->onNodeEnd();
+            break;
+        default:
+            return false;
+        }
+    }
+    return nodeStack.size() == 1;
+}
+
+std::string entryFileName(const std::string& path)
+{
+    constexpr auto hexDigits = std::string_view{"0123456789abcdef"};
+    auto hash = hashData(path);
+    auto fileName = std::string(16, '0');
+    for (auto it = fileName.rbegin(); it != fileName.rend(); ++it, hash >>= 4)
+        *it = hexDigits[hash & 0xf];
+    return fileName + ".shoalcache";
+}
+
+} //namespace
+
+EventRecorder::EventRecorder(IEventHandler& handler)
+    : handler_{handler}
+{
+}
+
+void EventRecorder::onNodeBegin(std::string_view name, const StreamPosition& position)
+{
+    writeValue(events_, EventType::NodeBegin);
+    writeValue(events_, name);
+    writeValue(events_, position);
+    handler_.onNodeBegin(name, position);
+}
+
+void EventRecorder::onNodeListBegin(std::string_view name, const StreamPosition& position)
+{
+    writeValue(events_, EventType::NodeListBegin);
+    writeValue(events_, name);
+    writeValue(events_, position);
+    handler_.onNodeListBegin(name, position);
+}
+
+void EventRecorder::onListElement(const StreamPosition& position)
+{
+    writeValue(events_, EventType::ListElement);
+    writeValue(events_, position);
+    handler_.onListElement(position);
+}
+
+void EventRecorder::onParam(std::string_view name, std::string_view value, const ParamPosition& position)
+{
+    writeValue(events_, EventType::Param);
+    writeValue(events_, name);
+    writeValue(events_, value);
+    writeValue(events_, position.resolve());
+    handler_.onParam(name, value, position);
+}
+
+void EventRecorder::onParamList(
+        std::string_view name,
+        const std::vector<std::string_view>& valueList,
+        const ParamPosition& position)
+{
+    writeValue(events_, EventType::ParamList);
+    writeValue(events_, name);
+    writeValue(events_, static_cast<std::uint32_t>(valueList.size()));
+    for (const auto& value : valueList)
+        writeValue(events_, value);
+    writeValue(events_, position.resolve());
+    handler_.onParamList(name, valueList, position);
+}
+
+void EventRecorder::onNodeEnd()
+{
+    writeValue(events_, EventType::NodeEnd);
+    handler_.onNodeEnd();
+}
+
+const std::string& EventRecorder::events() const
+{
+    return events_;
+}
+
+ParseCache::ParseCache(const std::filesystem::path& directory, const std::filesystem::path& path, std::string_view data)
+    : size_{data.size()}
+    , contentHash_{hashData(data)}
+{
+    auto error = std::error_code{};
+    auto filePath = std::filesystem::weakly_canonical(std::filesystem::absolute(path), error);
+    path_ = (error ? path : filePath).string();
+    entryPath_ = directory / entryFileName(path_);
+
+    const auto modificationTime = std::filesystem::last_write_time(path, error);
+    if (!error)
+        modificationTime_ = static_cast<std::int64_t>(modificationTime.time_since_epoch().count());
+}
+
+std::string ParseCache::header() const
+{
+    auto result = std::string{entryFormat};
+    writeValue(result, std::string_view{path_});
+    writeValue(result, size_);
+    writeValue(result, modificationTime_);
+    writeValue(result, contentHash_);
+    return result;
+}
+
+bool ParseCache::read(IEventHandler& handler) const
+{
+    auto error = std::error_code{};
+    if (!std::filesystem::exists(entryPath_, error))
+        return false;
+
+    auto entry = std::unique_ptr<MappedFile>{};
+    try {
+        entry = std::make_unique<MappedFile>(entryPath_);
+    }
+    catch (const ConfigError&) {
+        return false;
+    }
+
+    const auto header = this->header();
+    const auto data = entry->data();
+    if (data.substr(0, header.size()) != header)
+        return false;
+    // The events are validated before the replay, so the handler doesn't receive a part of a broken entry
+    const auto events = data.substr(header.size());
+    if (!replayEvents(events, nullptr))
+        return false;
+    replayEvents(events, &handler);
+    return true;
+}
+
+void ParseCache::write(const std::string& events) const
+{
+    auto error = std::error_code{};
+    std::filesystem::create_directories(entryPath_.parent_path(), error);
+
+    // Other processes can read the entry while it's being stored, so it's written to a temporary file first
+    const auto uniqueId = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+            static_cast<std::size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    const auto tempPath = entryPath_.string() + "." + std::to_string(uniqueId) + ".tmp";
+    {
+        auto file = std::ofstream{tempPath, std::ios::binary};
+        const auto header = this->header();
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(events.data(), static_cast<std::streamsize>(events.size()));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, entryPath_, error);
+    if (error)
+        std::filesystem::remove(tempPath, error);
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,53 @@
+#pragma once
+#include <figcone_shoal/ieventhandler.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+// Forwards the parsing events to the handler and serializes them for the parse cache
+class EventRecorder : public IEventHandler {
+public:
+    explicit EventRecorder(IEventHandler& handler);
+    void onNodeBegin(std::string_view name, const StreamPosition& position) override;
+    void onNodeListBegin(std::string_view name, const StreamPosition& position) override;
+    void onListElement(const StreamPosition& position) override;
+    void onParam(std::string_view name, std::string_view value, const ParamPosition& position) override;
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position) override;
+    void onNodeEnd() override;
+
+    const std::string& events() const;
+
+private:
+    IEventHandler& handler_;
+    std::string events_;
+};
+
+// Directory storing the serialized parsing events of config files. An entry is used only if the file has the same
+// path, size, modification time and content hash as when the entry was stored.
+class ParseCache {
+public:
+    ParseCache(const std::filesystem::path& directory, const std::filesystem::path& path, std::string_view data);
+    // Replays the events of the valid entry into the handler, returns false if there's none
+    bool read(IEventHandler& handler) const;
+    // Failing to store the entry isn't an error, the file is parsed again next time
+    void write(const std::string& events) const;
+
+private:
+    std::string header() const;
+
+private:
+    std::filesystem::path entryPath_;
+    std::string path_;
+    std::uint64_t size_ = 0;
+    std::int64_t modificationTime_ = 0;
+    std::uint64_t contentHash_ = 0;
+};
+
+} //namespace figcone::shoal::detail
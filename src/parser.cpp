@@ -1,15 +1,233 @@
+#include "chunkparamreader.h"
+#include "compiledimagebuilder.h"
+#include "lazyindexbuilder.h"
+#include "listelementreader.h"
+#include "mappedfile.h"
 #include "nodeparser.h"
+#include "parsecache.h"
 #include "stream.h"
+#include "treebuilder.h"
+#include "utils.h"
+#include "workstealingpool.h"
 #include <figcone_shoal/parser.h>
+#include <figcone_tree/errors.h>
+#include <fstream>
 
 namespace figcone::shoal {
 
+namespace {
+
+class EventDiscarder : public IEventHandler {
+public:
+    void onNodeBegin(std::string_view, const StreamPosition&) override {}
+    void onNodeListBegin(std::string_view, const StreamPosition&) override {}
+    void onListElement(const StreamPosition&) override {}
+    void onParam(std::string_view, std::string_view, const ParamPosition&) override {}
+    void onParamList(std::string_view, const std::vector<std::string_view>&, const ParamPosition&) override {}
+    void onNodeEnd() override {}
+};
+
+} //namespace
+
 Tree Parser::parse(std::istream& stream)
 {
     auto inputStream = detail::Stream{stream};
-    auto rootNode = makeTreeRoot();
-    detail::parseNode(inputStream, *rootNode, "");
-    return Tree{std::move(rootNode)};
+    return parseStream(inputStream);
+}
+
+Tree Parser::parse(std::string_view data)
+{
+    auto inputStream = detail::Stream{data};
+    return parseStream(inputStream);
+}
+
+ParseResult Parser::tryParse(std::istream& stream)
+{
+    auto inputStream = detail::Stream{stream};
+    return tryParseStream(inputStream);
+}
+
+ParseResult Parser::tryParse(std::string_view data)
+{
+    auto inputStream = detail::Stream{data};
+    return tryParseStream(inputStream);
+}
+
+RecoveredParseResult Parser::parseWithRecovery(std::istream& stream, bool isPartialTreeRequested)
+{
+    auto inputStream = detail::Stream{stream};
+    return parseStreamWithRecovery(inputStream, isPartialTreeRequested);
+}
+
+RecoveredParseResult Parser::parseWithRecovery(std::string_view data, bool isPartialTreeRequested)
+{
+    auto inputStream = detail::Stream{data};
+    return parseStreamWithRecovery(inputStream, isPartialTreeRequested);
+}
+
+Tree Parser::parseFile(const std::filesystem::path& path)
+{
+    auto treeBuilder = detail::TreeBuilder{};
+    parseFile(path, treeBuilder);
+    return treeBuilder.release();
+}
+
+void Parser::parse(std::istream& stream, IEventHandler& handler)
+{
+    auto inputStream = detail::Stream{stream};
+    parseStream(inputStream, handler);
+}
+
+void Parser::parse(std::string_view data, IEventHandler& handler)
+{
+    auto inputStream = detail::Stream{data};
+    parseStream(inputStream, handler);
+}
+
+void Parser::parseFile(const std::filesystem::path& path, IEventHandler& handler)
+{
+    const auto file = detail::MappedFile{path};
+    if (parseCacheDirectory_.empty()) {
+        auto inputStream = detail::Stream{file.data()};
+        parseStream(inputStream, handler);
+        return;
+    }
+
+    const auto parseCache = detail::ParseCache{parseCacheDirectory_, path, file.data()};
+    if (parseCache.read(handler)) {
+        stringInterningReport_ = {};
+        return;
+    }
+    auto eventRecorder = detail::EventRecorder{handler};
+    auto inputStream = detail::Stream{file.data()};
+    parseStream(inputStream, eventRecorder);
+    parseCache.write(eventRecorder.events());
+}
+
+LazyDocument Parser::parseLazy(std::string_view data)
+{
+    return detail::LazyIndexBuilder::build(data);
+}
+
+LazyDocument Parser::parseFileLazy(const std::filesystem::path& path)
+{
+    auto file = std::make_unique<detail::MappedFile>(path);
+    const auto data = file->data();
+    return detail::LazyIndexBuilder::build(data, std::move(file));
+}
+
+IncrementalDocument Parser::parseIncremental(std::string text)
+{
+    return IncrementalDocument{std::move(text)};
+}
+
+std::string Parser::compile(std::string_view data)
+{
+    auto imageBuilder = detail::CompiledImageBuilder{};
+    parse(data, imageBuilder);
+    return imageBuilder.release();
+}
+
+void Parser::compileFile(const std::filesystem::path& path, const std::filesystem::path& outputPath)
+{
+    auto imageBuilder = detail::CompiledImageBuilder{};
+    parseFile(path, imageBuilder);
+    const auto image = imageBuilder.release();
+
+    auto file = std::ofstream{outputPath, std::ios::binary};
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    if (!file)
+        throw ConfigError{"Can't write compiled config file '" + outputPath.string() + "'"};
+}
+
+CompiledConfig Parser::loadCompiled(std::string_view image)
+{
+    return CompiledConfig{nullptr, image};
+}
+
+CompiledConfig Parser::loadCompiledFile(const std::filesystem::path& path)
+{
+    auto file = std::make_unique<detail::MappedFile>(path);
+    const auto data = file->data();
+    return CompiledConfig{std::move(file), data};
+}
+
+void Parser::enableStringInterning(bool state)
+{
+    isStringInterningEnabled_ = state;
+}
+
+const StringInterningReport& Parser::stringInterningReport() const
+{
+    return stringInterningReport_;
+}
+
+void Parser::enableParallelParsing(std::size_t threadCount)
+{
+    parallelParsingThreadCount_ = threadCount;
+}
+
+void Parser::enableParseCache(const std::filesystem::path& directory)
+{
+    parseCacheDirectory_ = directory;
+}
+
+Tree Parser::parseStream(detail::Stream& stream)
+{
+    auto treeBuilder = detail::TreeBuilder{};
+    parseStream(stream, treeBuilder);
+    return treeBuilder.release();
+}
+
+void Parser::parseStream(detail::Stream& stream, IEventHandler& handler)
+{
+    detail::valueOrThrow(tryParseStream(stream, handler));
+}
+
+ParseResult Parser::tryParseStream(detail::Stream& stream)
+{
+    auto treeBuilder = detail::TreeBuilder{};
+    if (const auto result = tryParseStream(stream, treeBuilder); !result)
+        return result.error();
+    return treeBuilder.release();
+}
+
+RecoveredParseResult Parser::parseStreamWithRecovery(detail::Stream& stream, bool isPartialTreeRequested)
+{
+    auto result = RecoveredParseResult{};
+    if (!isPartialTreeRequested) {
+        auto eventDiscarder = EventDiscarder{};
+        tryParseStream(stream, eventDiscarder, &result.errors);
+        return result;
+    }
+    auto treeBuilder = detail::TreeBuilder{};
+    tryParseStream(stream, treeBuilder, &result.errors);
+    result.tree = treeBuilder.release();
+    return result;
+}
+
+Expected<void> Parser::tryParseStream(detail::Stream& stream, IEventHandler& handler, std::vector<ParseError>* errors)
+{
+    stringInterningReport_ = {};
+    if (isStringInterningEnabled_)
+        stream.enableStringInterning();
+
+    const auto structuralIndex = stream.structuralIndex();
+    if (parallelParsingThreadCount_ > 1 && structuralIndex &&
+        stream.data().size() >= detail::ListElementReader::minInputSize) {
+        auto pool = detail::WorkStealingPool{parallelParsingThreadCount_};
+        auto listElementReader = detail::ListElementReader{stream.data(), *structuralIndex, pool};
+        auto chunkParamReader = detail::ChunkParamReader{stream.data(), *structuralIndex, pool};
+        if (const auto result =
+                    detail::parseRootNode(stream, handler, &chunkParamReader, &listElementReader, errors);
+            !result)
+            return result;
+    }
+    else if (const auto result = detail::parseRootNode(stream, handler, nullptr, nullptr, errors); !result)
+        return result;
+    if (const auto stringPool = stream.stringPool())
+        stringInterningReport_ = {stringPool->reusedCount(), stringPool->savedSize()};
+    return {};
 }
 
 } //namespace figcone::shoal
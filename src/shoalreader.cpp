@@ -0,0 +1,74 @@
+#include "nodereader.h"
+#include "stream.h"
+#include <figcone_shoal/shoalreader.h>
+#include <gsl/assert>
+
+namespace figcone::shoal {
+
+ShoalReader::ShoalReader(std::istream& stream)
+    : stream_{std::make_unique<detail::Stream>(stream)}
+    , reader_{std::make_unique<detail::NodeReader>(*stream_)}
+{
+}
+
+ShoalReader::ShoalReader(std::string_view data)
+    : stream_{std::make_unique<detail::Stream>(data)}
+    , reader_{std::make_unique<detail::NodeReader>(*stream_)}
+{
+}
+
+ShoalReader::~ShoalReader() = default;
+
+ReaderEvent ShoalReader::next()
+{
+    return reader_->next();
+}
+
+void ShoalReader::skipNode()
+{
+    const auto event = reader_->event();
+    Expects(event == ReaderEvent::NodeBegin || event == ReaderEvent::NodeListBegin ||
+            event == ReaderEvent::ListElement);
+
+    const auto nodeDepth = reader_->depth();
+    while (true) {
+        const auto nextEvent = reader_->next();
+        if (nextEvent == ReaderEvent::DocumentEnd ||
+            (nextEvent == ReaderEvent::NodeEnd && reader_->depth() < nodeDepth))
+            return;
+    }
+}
+
+ReaderEvent ShoalReader::event() const
+{
+    return reader_->event();
+}
+
+std::string_view ShoalReader::name() const
+{
+    return reader_->name();
+}
+
+std::string_view ShoalReader::value() const
+{
+    Expects(reader_->event() == ReaderEvent::Param);
+    return reader_->param().valueList.at(0);
+}
+
+const std::vector<std::string_view>& ShoalReader::valueList() const
+{
+    Expects(reader_->event() == ReaderEvent::ParamList);
+    return reader_->param().valueList;
+}
+
+StreamPosition ShoalReader::position() const
+{
+    return stream_->position(reader_->eventOffset());
+}
+
+std::size_t ShoalReader::depth() const
+{
+    return reader_->depth();
+}
+
+} //namespace figcone::shoal
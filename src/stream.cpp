@@ -1,35 +1,46 @@
 #include "stream.h"
+#include "charscan.h"
+#include <gsl/assert>
 
 namespace figcone::shoal::detail {
 
+namespace {
+constexpr auto fetchBlockSize = std::size_t{64 * 1024};
+constexpr auto lineSeparatorChars = CharSet{"\r\n"};
+} //namespace
+
 Stream::Stream(std::istream& stream, const StreamPosition& startPosition)
-    : stream_(stream)
+    : stream_(&stream)
+    , startPosition_(startPosition)
+{
+}
+
+Stream::Stream(std::string_view data, const StreamPosition& startPosition)
+    : data_(data.data())
+    , size_(data.size())
     , startPosition_(startPosition)
 {
 }
 
 void Stream::skip(int size)
 {
-    read(size);
+    for (auto i = 0; i < size; ++i)
+        readChar();
 }
 
 void Stream::skipLineSeparator()
 {
     auto ch = char{};
-    auto pos = stream_.tellg();
-    if (!stream_.get(ch))
+    if (!readRaw(ch))
         return;
     if (ch == '\n')
         return;
     else if (ch == '\r') {
-        pos = stream_.tellg();
-        if (!stream_.get(ch))
-            return;
-        if (ch != '\n')
-            stream_.seekg(pos);
+        if (peekRaw(0, ch) && ch == '\n')
+            pos_++;
     }
     else
-        stream_.seekg(pos);
+        pos_--;
 }
 
 void Stream::skipComments(bool state)
@@ -37,89 +48,251 @@ void Stream::skipComments(bool state)
     skipComments_ = state;
 }
 
-std::string Stream::read(int size)
+char Stream::readChar()
+{
+    auto ch = char{};
+    if (!readRaw(ch))
+        return '\0';
+    if (skipComments_ && ch == ';') {
+        skipLine();
+        if (!readRaw(ch))
+            return '\0';
+    }
+
+    if (ch == '\r') {
+        auto nextCh = char{};
+        if (peekRaw(0, nextCh) && nextCh == '\n')
+            pos_++;
+        ch = '\n';
+    }
+    return ch;
+}
+
+char Stream::peekChar()
+{
+    auto ch = char{};
+    if (!peekRaw(0, ch))
+        return '\0';
+    if (skipComments_ && ch == ';' && !peekRaw(findLineEnd(1), ch))
+        return '\0';
+    return ch == '\r' ? '\n' : ch;
+}
+
+bool Stream::peekMatches(std::string_view str)
 {
-    auto result = std::string{};
     auto ch = char{};
-    for (auto i = 0; i < size; ++i) {
-        if (!stream_.get(ch))
-            return {};
+    auto offset = std::size_t{};
+    for (auto expectedCh : str) {
+        if (!peekRaw(offset++, ch))
+            return false;
         if (skipComments_ && ch == ';') {
-            skipLine();
-            continue;
+            offset = findLineEnd(offset);
+            if (!peekRaw(offset++, ch))
+                return false;
         }
-        if (ch == '\r' && peek() == "\n") {
-            i--;
-            continue;
-        }
-        else if (ch == '\r' || ch == '\n') {
-            (*position_.line)++;
-            (*position_.column) = 0;
+        if (ch == '\r') {
+            auto nextCh = char{};
+            if (peekRaw(offset, nextCh) && nextCh == '\n')
+                offset++;
             ch = '\n';
         }
-        else if (ch == '\t')
-            (*position_.column) += 4;
-        else
-            (*position_.column)++;
-        result.push_back(ch);
+        if (ch != expectedCh)
+            return false;
     }
-    return result;
+    return true;
 }
 
-std::string Stream::peek(int size)
+std::string_view Stream::readSpan(const CharSet& stopChars)
 {
-    auto result = std::string{};
     auto ch = char{};
-    auto pos = stream_.tellg();
-    for (auto i = 0; i < size; ++i) {
-        if (!stream_.get(ch)) {
-            stream_.clear();
-            result.clear();
-            break;
-        }
-        if (skipComments_ && ch == ';') {
-            skipLine();
-            i--;
-        }
-        else if (ch == '\r') {
-            auto crPos = stream_.tellg();
-            if (stream_.get(ch)) {
-                if (ch != '\n')
-                    stream_.seekg(crPos);
-            }
-            else
-                stream_.clear();
-
-            result.push_back('\n');
-        }
-        else
-            result.push_back(ch);
+    if (!peekRaw(0, ch))
+        return {};
+
+    auto spanStopChars = stopChars;
+    spanStopChars.add(lineSeparatorChars.chars());
+    if (skipComments_)
+        spanStopChars.add(';');
+
+    const auto begin = data_ + pos_;
+    const auto size = static_cast<std::size_t>(findFirstOf(begin, data_ + size_, spanStopChars) - begin);
+    advance(size);
+    return {begin, size};
+}
+
+void Stream::skipWhile(const CharSet& chars)
+{
+    Expects(!chars.contains('\r') && !chars.contains('\n') && !chars.contains(';'));
+
+    auto ch = char{};
+    while (peekRaw(0, ch)) {
+        const auto begin = data_ + pos_;
+        const auto end = data_ + size_;
+        const auto spanEnd = findFirstNotOf(begin, end, chars);
+        advance(static_cast<std::size_t>(spanEnd - begin));
+        if (spanEnd != end)
+            return;
     }
-    stream_.seekg(pos);
-    return result;
 }
 
 bool Stream::atEnd()
 {
-    return peek().empty();
+    auto ch = char{};
+    if (!peekRaw(0, ch))
+        return true;
+    if (skipComments_ && ch == ';')
+        return !peekRaw(findLineEnd(1), ch);
+    return false;
+}
+
+std::size_t Stream::offset() const
+{
+    return dataOffset_ + pos_;
+}
+
+const StructuralIndex* Stream::structuralIndex()
+{
+    if (stream_)
+        return nullptr;
+    if (!structuralIndex_)
+        structuralIndex_ = &ownStructuralIndex_.emplace(data());
+    return structuralIndex_;
+}
+
+void Stream::setStructuralIndex(const StructuralIndex& index)
+{
+    Expects(!stream_);
+    structuralIndex_ = &index;
+}
+
+std::string_view Stream::data() const
+{
+    Expects(!stream_);
+    return {data_, size_};
 }
 
-StreamPosition Stream::position() const
+void Stream::skipTo(std::size_t offset)
 {
-    return {*startPosition_.line + *position_.line, *startPosition_.column + *position_.column};
+    Expects(!stream_ && offset >= pos_ && offset <= size_);
+    pos_ = offset;
+}
+
+void Stream::seek(std::size_t offset)
+{
+    Expects(!stream_ && offset <= size_);
+    pos_ = offset;
+    skipComments_ = true;
+}
+
+StreamPosition Stream::position()
+{
+    return position(offset());
+}
+
+StreamPosition Stream::position(std::size_t offset)
+{
+    Expects(offset <= dataOffset_ + size_);
+    if (!isPositionEnabled_)
+        return {};
+    if (lineIndex_.size() < offset)
+        lineIndex_.extend({data_ + (lineIndex_.size() - dataOffset_), offset - lineIndex_.size()});
+
+    const auto textPosition = lineIndex_.position(offset);
+    return {*startPosition_.line + textPosition.line, *startPosition_.column + textPosition.column};
+}
+
+void Stream::disablePositions()
+{
+    isPositionEnabled_ = false;
+}
+
+Arena& Stream::arena()
+{
+    return arena_;
+}
+
+void Stream::enableStringInterning()
+{
+    if (!stringPool_)
+        stringPool_.emplace(arena_);
+}
+
+std::string_view Stream::intern(std::string_view str)
+{
+    if (!stringPool_)
+        return str;
+    return stringPool_->intern(str);
+}
+
+const StringPool* Stream::stringPool() const
+{
+    return stringPool_ ? &*stringPool_ : nullptr;
 }
 
 void Stream::skipLine()
+{
+    pos_ += findLineEnd(0);
+}
+
+bool Stream::readRaw(char& ch)
+{
+    if (!peekRaw(0, ch))
+        return false;
+    pos_++;
+    return true;
+}
+
+bool Stream::peekRaw(std::size_t offset, char& ch)
+{
+    if (size_ - pos_ <= offset && !fetch(offset + 1))
+        return false;
+    ch = data_[pos_ + offset];
+    return true;
+}
+
+std::size_t Stream::findLineEnd(std::size_t offset)
 {
     auto ch = char{};
-    auto prevPos = stream_.tellg();
-    while (stream_.get(ch)) {
-        if (ch == '\r' || ch == '\n') {
-            stream_.seekg(prevPos);
+    while (peekRaw(offset, ch)) {
+        const auto begin = data_ + pos_ + offset;
+        const auto end = data_ + size_;
+        const auto lineEnd = findFirstOf(begin, end, lineSeparatorChars);
+        offset += static_cast<std::size_t>(lineEnd - begin);
+        if (lineEnd != end)
             break;
-        }
-        prevPos = stream_.tellg();
     }
+    return offset;
+}
+
+void Stream::advance(std::size_t size)
+{
+    pos_ += size;
+}
+
+bool Stream::fetch(std::size_t size)
+{
+    if (!stream_)
+        return false;
+
+    while (size_ - pos_ < size) {
+        if (!*stream_)
+            return false;
+
+        // Discarded data must be indexed to resolve the positions inside it later
+        if (lineIndex_.size() < dataOffset_ + pos_)
+            lineIndex_.extend({data_ + (lineIndex_.size() - dataOffset_), dataOffset_ + pos_ - lineIndex_.size()});
+        buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(pos_));
+        dataOffset_ += pos_;
+        pos_ = 0;
+        const auto prevSize = buffer_.size();
+        buffer_.resize(prevSize + fetchBlockSize);
+        stream_->read(&buffer_[prevSize], static_cast<std::streamsize>(fetchBlockSize));
+        buffer_.resize(prevSize + static_cast<std::size_t>(stream_->gcount()));
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        if (size_ == prevSize)
+            return false;
+    }
+    return true;
 }
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
@@ -1,33 +1,92 @@
 #pragma once
+#include "arena.h"
+#include "charset.h"
+#include "lineindex.h"
+#include "stringpool.h"
+#include "structuralindex.h"
 #include <figcone_tree/streamposition.h>
+#include <cstddef>
 #include <istream>
-#include <string>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace figcone::shoal::detail {
 
 class Stream {
 public:
     explicit Stream(std::istream& stream, const StreamPosition& startPosition = StreamPosition{1, 1});
-    Stream(Stream&&) = default;
+    explicit Stream(std::string_view data, const StreamPosition& startPosition = StreamPosition{1, 1});
+    Stream(Stream&&) = delete;
     Stream(const Stream&) = delete;
     Stream& operator=(const Stream&) = delete;
+    Stream& operator=(Stream&&) = delete;
 
     void skip(int size);
     void skipLineSeparator();
     void skipComments(bool state);
-    std::string read(int size = 1);
-    std::string peek(int size = 1);
+    char readChar();
+    char peekChar();
+    template<std::size_t N>
+    bool peekMatches(const char (&str)[N])
+    {
+        return peekMatches(std::string_view{str, N - 1});
+    }
+    // Reads characters up to the first one from stopChars or the one requiring
+    // line separator or comment handling. The result is valid until the next read.
+    std::string_view readSpan(const CharSet& stopChars);
+    // Skips characters from chars, which can't contain line separators or the comment character.
+    void skipWhile(const CharSet& chars);
     bool atEnd();
-    StreamPosition position() const;
+    std::size_t offset() const;
+    // Structural index of the in-memory input, which is built on the first call.
+    // Returns nullptr for the input read from std::istream.
+    const StructuralIndex* structuralIndex();
+    // Makes the stream use the index built for the same data by another stream
+    void setStructuralIndex(const StructuralIndex& index);
+    // In-memory input, the offsets are relative to its beginning
+    std::string_view data() const;
+    // Moves to the offset in the in-memory input, without any line separator or comment handling
+    void skipTo(std::size_t offset);
+    // Moves to any offset in the in-memory input and resets the reading state,
+    // so the stream can be reused after a reading that was stopped by an error
+    void seek(std::size_t offset);
+    StreamPosition position();
+    StreamPosition position(std::size_t offset);
+    // Speculative readers discard the errors they find, so the stream returns empty positions
+    // for them instead of indexing the lines of the input
+    void disablePositions();
+    // Storage for transient strings read during the parsing
+    Arena& arena();
+    void enableStringInterning();
+    // Returns the previously read string equal to str when the string interning is enabled
+    std::string_view intern(std::string_view str);
+    const StringPool* stringPool() const;
 
 private:
+    bool peekMatches(std::string_view str);
     void skipLine();
+    bool readRaw(char& ch);
+    bool peekRaw(std::size_t offset, char& ch);
+    std::size_t findLineEnd(std::size_t offset);
+    void advance(std::size_t size);
+    bool fetch(std::size_t size);
 
 private:
-    std::istream& stream_;
-    StreamPosition position_ = {0, 0};
+    std::istream* stream_ = nullptr;
+    std::vector<char> buffer_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t dataOffset_ = 0;
+    LineIndex lineIndex_;
+    Arena arena_;
+    std::optional<StringPool> stringPool_;
+    std::optional<StructuralIndex> ownStructuralIndex_;
+    const StructuralIndex* structuralIndex_ = nullptr;
     StreamPosition startPosition_ = {0, 0};
     bool skipComments_ = true;
+    bool isPositionEnabled_ = true;
 };
 
 } //namespace figcone::shoal::detail
@@ -0,0 +1,38 @@
+#include "stringpool.h"
+
+namespace figcone::shoal::detail {
+
+StringPool::StringPool(Arena& arena)
+    : arena_{arena}
+    , strings_{0, std::hash<std::string_view>{}, std::equal_to<std::string_view>{}, ArenaAllocator<std::string_view>{arena}}
+{
+}
+
+std::string_view StringPool::intern(std::string_view str)
+{
+    if (str.empty() || str.size() > maxInternedSize)
+        return str;
+
+    const auto it = strings_.find(str);
+    if (it == strings_.end()) {
+        strings_.insert(str);
+        return str;
+    }
+
+    reusedCount_++;
+    if (arena_.release(str.data(), str.size()))
+        savedSize_ += str.size();
+    return *it;
+}
+
+std::size_t StringPool::reusedCount() const
+{
+    return reusedCount_;
+}
+
+std::size_t StringPool::savedSize() const
+{
+    return savedSize_;
+}
+
+} //namespace figcone::shoal::detail
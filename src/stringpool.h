@@ -0,0 +1,35 @@
+#pragma once
+#include "arena.h"
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
+namespace figcone::shoal::detail {
+
+// Deduplicates strings stored in the arena, so repeated param names and values
+// (e.g. in every element of a node list) share the same storage.
+class StringPool {
+public:
+    static constexpr auto maxInternedSize = std::size_t{64};
+
+    explicit StringPool(Arena& arena);
+    // Returns the stored copy of str, if there is one, and releases str when it's the last arena allocation.
+    std::string_view intern(std::string_view str);
+    std::size_t reusedCount() const;
+    // Size of the released duplicates
+    std::size_t savedSize() const;
+
+private:
+    Arena& arena_;
+    std::unordered_set<
+            std::string_view,
+            std::hash<std::string_view>,
+            std::equal_to<std::string_view>,
+            ArenaAllocator<std::string_view>>
+            strings_;
+    std::size_t reusedCount_ = 0;
+    std::size_t savedSize_ = 0;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,432 @@
+#include "structschema.h"
+#include <figcone_shoal/structgenerator.h>
+#include <figcone_shoal/structreader.h>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <sstream>
+
+namespace figcone::shoal {
+
+namespace {
+
+using detail::ConfigSchema;
+using detail::FieldSchema;
+using detail::StructSchema;
+
+struct PerfectHash {
+    std::uint32_t seed;
+    std::uint32_t mask;
+};
+
+// Finds the seed of structKeyHash() that maps every field name to its own slot of the smallest possible table
+PerfectHash findPerfectHash(const std::vector<FieldSchema>& fields)
+{
+    constexpr auto maxSeed = 4096u;
+    auto tableSize = 1u;
+    while (tableSize < fields.size())
+        tableSize *= 2;
+
+    for (;; tableSize *= 2) {
+        for (auto seed = 0u; seed < maxSeed; ++seed) {
+            auto slots = std::set<std::uint32_t>{};
+            for (const auto& field : fields)
+                if (!slots.insert(structKeyHash(field.name, seed) & (tableSize - 1)).second)
+                    break;
+            if (slots.size() == fields.size())
+                return {seed, tableSize - 1};
+        }
+    }
+}
+
+bool isNodeField(const FieldSchema& field)
+{
+    return field.structType != nullptr;
+}
+
+std::string fieldBit(std::size_t fieldIndex)
+{
+    return "std::uint64_t{1} << " + std::to_string(fieldIndex);
+}
+
+class StructReaderGenerator {
+public:
+    explicit StructReaderGenerator(const ConfigSchema& schema)
+        : schema_{schema}
+    {
+        for (const auto& structSchema : schema_.structs)
+            for (const auto& field : structSchema->fields)
+                if (isNodeField(field) && field.isList)
+                    listStructs_.insert(field.structType);
+    }
+
+    std::string generate()
+    {
+        writeHeader();
+        if (!schema_.namespaceName.empty())
+            out_ << "namespace " << schema_.namespaceName << " {\n\n";
+        if (schema_.includes.empty()) {
+            auto declaredStructs = std::set<const StructSchema*>{};
+            for (const auto& structSchema : schema_.structs)
+                writeStruct(*structSchema, declaredStructs);
+        }
+        writeReader();
+        writeParseFunctions();
+        if (!schema_.namespaceName.empty())
+            out_ << "} //namespace " << schema_.namespaceName << "\n";
+        return out_.str();
+    }
+
+private:
+    void writeHeader()
+    {
+        out_ << "// Generated by shoalgen from a config schema, don't edit it manually\n"
+             << "#pragma once\n";
+        for (const auto& include : schema_.includes) {
+            if (include.front() == '<')
+                out_ << "#include " << include << "\n";
+            else
+                out_ << "#include \"" << include << "\"\n";
+        }
+        out_ << "#include <figcone_shoal/structreader.h>\n"
+             << "#include <cstdint>\n"
+             << "#include <filesystem>\n"
+             << "#include <optional>\n"
+             << "#include <string>\n"
+             << "#include <string_view>\n"
+             << "#include <vector>\n\n";
+    }
+
+    // Structs are declared after the structs of their fields
+    void writeStruct(const StructSchema& structSchema, std::set<const StructSchema*>& declaredStructs)
+    {
+        if (!declaredStructs.insert(&structSchema).second)
+            return;
+        for (const auto& field : structSchema.fields)
+            if (isNodeField(field))
+                writeStruct(*field.structType, declaredStructs);
+
+        out_ << "struct " << structSchema.name << " {\n";
+        for (const auto& field : structSchema.fields) {
+            out_ << "    " << fieldType(field) << " " << field.name;
+            if (!isNodeField(field) && !field.isList && !field.isOptional && field.valueType != "std::string")
+                out_ << "{}";
+            out_ << ";\n";
+        }
+        out_ << "};\n\n";
+    }
+
+    void writeReader()
+    {
+        const auto& root = rootStruct();
+        out_ << "class " << root.name << "Reader : public figcone::shoal::StructReaderBase {\n"
+             << "    enum FrameType {\n";
+        for (const auto& structSchema : schema_.structs) {
+            out_ << "        " << structSchema->name << "Item,\n";
+            if (listStructs_.count(structSchema.get()))
+                out_ << "        " << structSchema->name << "List,\n";
+        }
+        out_ << "    };\n\n"
+             << "public:\n"
+             << "    explicit " << root.name << "Reader(" << qualifiedName(root) << "& config)\n"
+             << "    {\n"
+             << "        beginFrame(" << root.name << "Item, &config, {});\n"
+             << "    }\n\n"
+             << "    // Checks the root struct after the parsing is finished\n"
+             << "    void finish()\n"
+             << "    {\n"
+             << "        endFrame(popFrame());\n"
+             << "    }\n\n"
+             << "    void onNodeBegin(std::string_view name, const figcone::StreamPosition& position) override\n"
+             << "    {\n"
+             << "        readNode(name, false, position);\n"
+             << "    }\n\n"
+             << "    void onNodeListBegin(std::string_view name, const figcone::StreamPosition& position) override\n"
+             << "    {\n"
+             << "        readNode(name, true, position);\n"
+             << "    }\n\n";
+        writeOnListElement();
+        out_ << "    void onParam(std::string_view name, std::string_view value, const figcone::shoal::ParamPosition& "
+                "position) override\n"
+             << "    {\n"
+             << "        readParam(name, value, position);\n"
+             << "    }\n\n"
+             << "    void onParamList(\n"
+             << "            std::string_view name,\n"
+             << "            const std::vector<std::string_view>& valueList,\n"
+             << "            const figcone::shoal::ParamPosition& position) override\n"
+             << "    {\n"
+             << "        readParam(name, valueList, position);\n"
+             << "    }\n\n"
+             << "    void onNodeEnd() override\n"
+             << "    {\n"
+             << "        endFrame(popFrame());\n"
+             << "    }\n"
+             << "\nprivate:\n";
+        writeReadNode();
+        out_ << "\n";
+        writeReadParam();
+        out_ << "\n";
+        writeEndFrame();
+        for (const auto& structSchema : schema_.structs) {
+            const auto hash = findPerfectHash(structSchema->fields);
+            writeReadStructNode(*structSchema, hash);
+            writeReadStructParam(*structSchema, hash);
+        }
+        out_ << "};\n\n";
+    }
+
+    void writeOnListElement()
+    {
+        if (listStructs_.empty()) {
+            out_ << "    void onListElement(const figcone::StreamPosition&) override {}\n\n";
+            return;
+        }
+        out_ << "    void onListElement(const figcone::StreamPosition& position) override\n"
+             << "    {\n"
+             << "        switch (currentFrame().type) {\n";
+        for (const auto& structSchema : schema_.structs) {
+            if (!listStructs_.count(structSchema.get()))
+                continue;
+            out_ << "        case " << structSchema->name << "List:\n"
+                 << "            beginListElement<" << qualifiedName(*structSchema) << ">(" << structSchema->name
+                 << "Item, position);\n"
+                 << "            break;\n";
+        }
+        out_ << "        }\n"
+             << "    }\n\n";
+    }
+
+    void writeReadNode()
+    {
+        out_ << "    void readNode(std::string_view name, bool isList, const figcone::StreamPosition& position)\n"
+             << "    {\n";
+        writeFrameSwitch(true);
+        out_ << "    }\n";
+    }
+
+    void writeReadParam()
+    {
+        out_ << "    template<typename TValue>\n"
+             << "    void readParam(std::string_view name, const TValue& value, const figcone::shoal::ParamPosition& "
+                "position)\n"
+             << "    {\n";
+        writeFrameSwitch(false);
+        out_ << "    }\n";
+    }
+
+    // Passes a node or param to the reading function of the struct that is currently filled
+    void writeFrameSwitch(bool isNode)
+    {
+        out_ << "        auto& frame = currentFrame();\n"
+             << "        switch (frame.type) {\n";
+        for (const auto& structSchema : schema_.structs) {
+            if (!hasFields(*structSchema, isNode))
+                continue;
+            out_ << "        case " << structSchema->name << "Item:\n"
+                 << "            read" << structSchema->name << (isNode ? "Node(\n" : "Param(\n")
+                 << "                    *static_cast<" << qualifiedName(*structSchema) << "*>(frame.object),\n"
+                 << "                    frame.readFields,\n"
+                 << "                    name,\n"
+                 << (isNode ? "                    isList,\n" : "                    value,\n")
+                 << "                    position);\n"
+                 << "            return;\n";
+        }
+        out_ << "        }\n";
+        if (isNode)
+            out_ << "        throwUnknownNode(name, position);\n";
+        else
+            out_ << "        throwUnknownParam(name, position);\n";
+    }
+
+    void writeEndFrame()
+    {
+        const auto hasRequiredFields = [](const StructSchema& structSchema)
+        {
+            return std::any_of(
+                    structSchema.fields.begin(),
+                    structSchema.fields.end(),
+                    [](const FieldSchema& field)
+                    {
+                        return !field.isOptional;
+                    });
+        };
+        if (std::none_of(
+                    schema_.structs.begin(),
+                    schema_.structs.end(),
+                    [&](const std::unique_ptr<StructSchema>& structSchema)
+                    {
+                        return hasRequiredFields(*structSchema);
+                    })) {
+            out_ << "    void endFrame(const Frame&) {}\n";
+            return;
+        }
+
+        out_ << "    void endFrame(const Frame& frame)\n"
+             << "    {\n"
+             << "        switch (frame.type) {\n";
+        for (const auto& structSchema : schema_.structs) {
+            if (!hasRequiredFields(*structSchema))
+                continue;
+            out_ << "        case " << structSchema->name << "Item:\n";
+            for (auto i = std::size_t{}; i < structSchema->fields.size(); ++i) {
+                const auto& field = structSchema->fields[i];
+                if (field.isOptional)
+                    continue;
+                out_ << "            if (!(frame.readFields & (" << fieldBit(i) << ")))\n"
+                     << "                throwMissing" << (isNodeField(field) ? "Node" : "Param") << "(\""
+                     << field.name << "\", frame.position);\n";
+            }
+            out_ << "            break;\n";
+        }
+        out_ << "        }\n"
+             << "    }\n";
+    }
+
+    void writeReadStructNode(const StructSchema& structSchema, const PerfectHash& hash)
+    {
+        if (!hasFields(structSchema, true))
+            return;
+        out_ << "\n    void read" << structSchema.name << "Node(\n"
+             << "            " << qualifiedName(structSchema) << "& object,\n"
+             << "            std::uint64_t& readFields,\n"
+             << "            std::string_view name,\n"
+             << "            bool isList,\n"
+             << "            const figcone::StreamPosition& position)\n"
+             << "    {\n";
+        writeFieldSwitch(
+                structSchema,
+                hash,
+                true,
+                [&](const FieldSchema& field, std::size_t fieldIndex)
+                {
+                    out_ << "                " << (field.isList ? "beginNodeList(" : "beginNode(")
+                         << field.structType->name << (field.isList ? "List" : "Item") << ", object." << field.name
+                         << ", readFields, " << fieldBit(fieldIndex) << ", name, isList, position);\n";
+                });
+        out_ << "        throwUnknownNode(name, position);\n"
+             << "    }\n";
+    }
+
+    void writeReadStructParam(const StructSchema& structSchema, const PerfectHash& hash)
+    {
+        if (!hasFields(structSchema, false))
+            return;
+        out_ << "\n    template<typename TValue>\n"
+             << "    static void read" << structSchema.name << "Param(\n"
+             << "            " << qualifiedName(structSchema) << "& object,\n"
+             << "            std::uint64_t& readFields,\n"
+             << "            std::string_view name,\n"
+             << "            const TValue& value,\n"
+             << "            const figcone::shoal::ParamPosition& position)\n"
+             << "    {\n";
+        writeFieldSwitch(
+                structSchema,
+                hash,
+                false,
+                [&](const FieldSchema& field, std::size_t fieldIndex)
+                {
+                    out_ << "                readField(object." << field.name << ", readFields, "
+                         << fieldBit(fieldIndex) << ", name, value, position);\n";
+                });
+        out_ << "        throwUnknownParam(name, position);\n"
+             << "    }\n";
+    }
+
+    // Every key is compared only with the field name in its slot of the perfect hash table
+    template<typename TWriteRead>
+    void writeFieldSwitch(
+            const StructSchema& structSchema,
+            const PerfectHash& hash,
+            bool isNode,
+            const TWriteRead& writeRead)
+    {
+        auto slots = std::vector<std::pair<std::uint32_t, std::size_t>>{};
+        for (auto i = std::size_t{}; i < structSchema.fields.size(); ++i)
+            if (isNodeField(structSchema.fields[i]) == isNode)
+                slots.emplace_back(structKeyHash(structSchema.fields[i].name, hash.seed) & hash.mask, i);
+        std::sort(slots.begin(), slots.end());
+
+        out_ << "        switch (figcone::shoal::structKeyHash(name, " << hash.seed << "u) & " << hash.mask << "u) {\n";
+        for (const auto& [slot, fieldIndex] : slots) {
+            const auto& field = structSchema.fields[fieldIndex];
+            out_ << "        case " << slot << "u:\n"
+                 << "            if (name == \"" << field.name << "\") {\n";
+            writeRead(field, fieldIndex);
+            out_ << "                return;\n"
+                 << "            }\n"
+                 << "            break;\n";
+        }
+        out_ << "        }\n";
+    }
+
+    void writeParseFunctions()
+    {
+        const auto& root = rootStruct();
+        for (const auto isFile : {false, true}) {
+            out_ << "inline " << root.name << " parse" << root.name << (isFile ? "File" : "")
+                 << (isFile ? "(const std::filesystem::path& path)\n" : "(std::string_view data)\n") << "{\n"
+                 << "    auto config = " << root.name << "{};\n"
+                 << "    auto reader = " << root.name << "Reader{config};\n"
+                 << "    figcone::shoal::Parser{}." << (isFile ? "parseFile(path" : "parse(data") << ", reader);\n"
+                 << "    reader.finish();\n"
+                 << "    return config;\n"
+                 << "}\n\n";
+        }
+    }
+
+    static std::string fieldType(const FieldSchema& field)
+    {
+        auto type = field.valueType;
+        if (field.isList)
+            type = "std::vector<" + type + ">";
+        if (field.isOptional)
+            type = "std::optional<" + type + ">";
+        return type;
+    }
+
+    // User struct names are qualified inside the reader class, so they can't be shadowed by its base classes
+    std::string qualifiedName(const StructSchema& structSchema) const
+    {
+        if (schema_.namespaceName.empty())
+            return "::" + structSchema.name;
+        return "::" + schema_.namespaceName + "::" + structSchema.name;
+    }
+
+    const StructSchema& rootStruct() const
+    {
+        return **std::find_if(
+                schema_.structs.begin(),
+                schema_.structs.end(),
+                [&](const std::unique_ptr<StructSchema>& structSchema)
+                {
+                    return structSchema->name == schema_.rootStruct;
+                });
+    }
+
+    static bool hasFields(const StructSchema& structSchema, bool isNode)
+    {
+        return std::any_of(
+                structSchema.fields.begin(),
+                structSchema.fields.end(),
+                [&](const FieldSchema& field)
+                {
+                    return isNodeField(field) == isNode;
+                });
+    }
+
+private:
+    const ConfigSchema& schema_;
+    std::set<const StructSchema*> listStructs_;
+    std::ostringstream out_;
+};
+
+} //namespace
+
+std::string generateStructReader(std::string_view schema)
+{
+    const auto configSchema = detail::readConfigSchema(schema);
+    return StructReaderGenerator{configSchema}.generate();
+}
+
+} //namespace figcone::shoal
@@ -0,0 +1,234 @@
+#include "structschema.h"
+#include <figcone_shoal/ieventhandler.h>
+#include <figcone_shoal/parser.h>
+#include <figcone_tree/errors.h>
+#include <gsl/assert>
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+const auto valueTypes = std::map<std::string_view, std::string_view>{
+        {"string", "std::string"},
+        {"bool", "bool"},
+        {"int", "int"},
+        {"unsigned", "unsigned int"},
+        {"int64", "std::int64_t"},
+        {"uint64", "std::uint64_t"},
+        {"float", "float"},
+        {"double", "double"}};
+
+constexpr auto maxFieldsCount = 64u;
+
+bool isIdentifier(std::string_view str)
+{
+    if (str.empty() || std::isdigit(static_cast<unsigned char>(str.front())))
+        return false;
+    return std::all_of(
+            str.begin(),
+            str.end(),
+            [](char ch)
+            {
+                return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_';
+            });
+}
+
+bool isNamespace(std::string_view str)
+{
+    auto pos = std::size_t{};
+    while (true) {
+        const auto separatorPos = str.find("::", pos);
+        if (!isIdentifier(str.substr(pos, separatorPos - pos)))
+            return false;
+        if (separatorPos == std::string_view::npos)
+            return true;
+        pos = separatorPos + 2;
+    }
+}
+
+bool unwrapType(std::string_view& typeName, std::string_view wrapper)
+{
+    if (typeName.size() <= wrapper.size() + 2 || typeName.substr(0, wrapper.size()) != wrapper ||
+        typeName[wrapper.size()] != '<' || typeName.back() != '>')
+        return false;
+    typeName = typeName.substr(wrapper.size() + 1, typeName.size() - wrapper.size() - 2);
+    return true;
+}
+
+class SchemaReader : public IEventHandler {
+public:
+    explicit SchemaReader(ConfigSchema& schema)
+        : schema_{schema}
+    {
+    }
+
+    void onNodeBegin(std::string_view name, const StreamPosition& position) override
+    {
+        if (depth_++ > 0)
+            throw ConfigError{"Struct definitions can't be nested", position};
+        if (!isIdentifier(name))
+            throw ConfigError{"Struct name '" + std::string{name} + "' isn't a valid identifier", position};
+        schema_.structs.push_back(std::make_unique<StructSchema>(StructSchema{std::string{name}, position, {}}));
+    }
+
+    void onNodeListBegin(std::string_view name, const StreamPosition& position) override
+    {
+        throw ConfigError{"Struct '" + std::string{name} + "' can't be a node list", position};
+    }
+
+    void onListElement(const StreamPosition&) override
+    {
+        Expects(false);
+    }
+
+    void onParam(std::string_view name, std::string_view value, const ParamPosition& paramPosition) override
+    {
+        const auto position = paramPosition.resolve();
+        if (depth_ == 0) {
+            readSchemaParam(name, {value}, position);
+            return;
+        }
+        auto& fields = schema_.structs.back()->fields;
+        if (!isIdentifier(name))
+            throw ConfigError{"Field name '" + std::string{name} + "' isn't a valid identifier", position};
+        if (std::any_of(
+                    fields.begin(),
+                    fields.end(),
+                    [&](const FieldSchema& field)
+                    {
+                        return field.name == name;
+                    }))
+            throw ConfigError{"Field '" + std::string{name} + "' is already declared", position};
+        if (fields.size() == maxFieldsCount)
+            throw ConfigError{
+                    "Struct '" + schema_.structs.back()->name + "' can't have more than " +
+                            std::to_string(maxFieldsCount) + " fields",
+                    position};
+        fields.push_back(FieldSchema{std::string{name}, std::string{value}, position, {}, nullptr, false, false});
+    }
+
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& paramPosition) override
+    {
+        const auto position = paramPosition.resolve();
+        if (depth_ == 0 && name == "include") {
+            readSchemaParam(name, valueList, position);
+            return;
+        }
+        throw ConfigError{"Parameter '" + std::string{name} + "' can't be a list", position};
+    }
+
+    void onNodeEnd() override
+    {
+        --depth_;
+    }
+
+private:
+    void readSchemaParam(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const StreamPosition& position)
+    {
+        if (name == "include") {
+            schema_.includes.assign(valueList.begin(), valueList.end());
+            return;
+        }
+        const auto& value = valueList.front();
+        if (name == "root") {
+            if (!isIdentifier(value))
+                throw ConfigError{"Root struct name '" + std::string{value} + "' isn't a valid identifier", position};
+            schema_.rootStruct = value;
+        }
+        else if (name == "namespace") {
+            if (!isNamespace(value))
+                throw ConfigError{"Namespace '" + std::string{value} + "' isn't valid", position};
+            schema_.namespaceName = value;
+        }
+        else
+            throw ConfigError{"Unknown schema parameter '" + std::string{name} + "'", position};
+    }
+
+private:
+    ConfigSchema& schema_;
+    int depth_ = 0;
+};
+
+const StructSchema* findStruct(const ConfigSchema& schema, std::string_view name)
+{
+    const auto it = std::find_if(
+            schema.structs.begin(),
+            schema.structs.end(),
+            [&](const std::unique_ptr<StructSchema>& structSchema)
+            {
+                return structSchema->name == name;
+            });
+    if (it == schema.structs.end())
+        return nullptr;
+    return it->get();
+}
+
+void resolveFieldType(const ConfigSchema& schema, FieldSchema& field)
+{
+    auto typeName = std::string_view{field.typeName};
+    field.isOptional = unwrapType(typeName, "optional");
+    field.isList = unwrapType(typeName, "list");
+
+    const auto valueTypeIt = valueTypes.find(typeName);
+    if (valueTypeIt != valueTypes.end())
+        field.valueType = valueTypeIt->second;
+    else if ((field.structType = findStruct(schema, typeName)))
+        field.valueType = typeName;
+    else
+        throw ConfigError{"Unknown type '" + field.typeName + "' of field '" + field.name + "'", field.position};
+}
+
+// Struct fields are stored by value, so a struct can't contain itself
+void checkNestedStructs(
+        const StructSchema& structSchema,
+        std::vector<const StructSchema*>& nestingStack,
+        std::set<const StructSchema*>& checkedStructs)
+{
+    if (std::find(nestingStack.begin(), nestingStack.end(), &structSchema) != nestingStack.end())
+        throw ConfigError{"Struct '" + structSchema.name + "' contains itself", structSchema.position};
+    if (!checkedStructs.insert(&structSchema).second)
+        return;
+
+    nestingStack.push_back(&structSchema);
+    for (const auto& field : structSchema.fields)
+        if (field.structType)
+            checkNestedStructs(*field.structType, nestingStack, checkedStructs);
+    nestingStack.pop_back();
+}
+
+} //namespace
+
+ConfigSchema readConfigSchema(std::string_view schemaText)
+{
+    auto schema = ConfigSchema{};
+    auto reader = SchemaReader{schema};
+    Parser{}.parse(schemaText, reader);
+
+    if (schema.rootStruct.empty())
+        throw ConfigError{"Schema parameter 'root' is missing"};
+    if (!findStruct(schema, schema.rootStruct))
+        throw ConfigError{"Root struct '" + schema.rootStruct + "' isn't declared"};
+
+    for (auto& structSchema : schema.structs)
+        for (auto& field : structSchema->fields)
+            resolveFieldType(schema, field);
+
+    auto checkedStructs = std::set<const StructSchema*>{};
+    for (const auto& structSchema : schema.structs) {
+        auto nestingStack = std::vector<const StructSchema*>{};
+        checkNestedStructs(*structSchema, nestingStack, checkedStructs);
+    }
+    return schema;
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,40 @@
+#pragma once
+#include <figcone_tree/streamposition.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+struct StructSchema;
+
+struct FieldSchema {
+    std::string name;
+    std::string typeName;
+    StreamPosition position;
+    // The resolved type: a value or a struct, wrapped in optional<>, list<> or optional<list<>>
+    std::string valueType;
+    const StructSchema* structType = nullptr;
+    bool isList = false;
+    bool isOptional = false;
+};
+
+struct StructSchema {
+    std::string name;
+    StreamPosition position;
+    std::vector<FieldSchema> fields;
+};
+
+struct ConfigSchema {
+    std::string rootStruct;
+    std::string namespaceName;
+    std::vector<std::string> includes;
+    // Structs are stored by pointers, so the fields' structType stay valid
+    std::vector<std::unique_ptr<StructSchema>> structs;
+};
+
+// Reads and validates the schema of generateStructReader()
+ConfigSchema readConfigSchema(std::string_view schema);
+
+} //namespace figcone::shoal::detail
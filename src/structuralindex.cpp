@@ -0,0 +1,49 @@
+#include "structuralindex.h"
+#include "charscan.h"
+#include "charset.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace figcone::shoal::detail {
+
+namespace {
+constexpr auto blockSize = std::size_t{64};
+constexpr auto structuralChars = CharSet{"\r\n#-=,[]'\"`;"};
+
+std::size_t countTrailingZeros(std::uint64_t mask)
+{
+#ifdef _MSC_VER
+    auto index = 0ul;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(mask));
+#endif
+}
+
+} //namespace
+
+StructuralIndex::StructuralIndex(std::string_view data)
+    : masks_((data.size() + blockSize - 1) / blockSize)
+    , size_{data.size()}
+{
+    markCharsOf(data.data(), data.data() + data.size(), structuralChars, masks_.data());
+}
+
+std::size_t StructuralIndex::next(std::size_t offset) const
+{
+    auto blockIndex = offset / blockSize;
+    if (blockIndex >= masks_.size())
+        return size_;
+
+    auto mask = masks_[blockIndex] & (~std::uint64_t{} << (offset % blockSize));
+    while (!mask) {
+        if (++blockIndex == masks_.size())
+            return size_;
+        mask = masks_[blockIndex];
+    }
+    return blockIndex * blockSize + countTrailingZeros(mask);
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+// Bitmap of the characters that can change the parsing state: line separators, node and closing
+// token characters, '=', list punctuation, quotation marks and comments.
+// Whether a character is actually structural depends on the parsing state (e.g. a quotation mark
+// starts a string only at the beginning of a value), so the readers using the index resolve it.
+class StructuralIndex {
+public:
+    explicit StructuralIndex(std::string_view data);
+    // Returns the offset of the first indexed character at or after offset, or the data size
+    std::size_t next(std::size_t offset) const;
+
+private:
+    std::vector<std::uint64_t> masks_;
+    std::size_t size_;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,56 @@
+#include "treebuilder.h"
+#include <gsl/assert>
+#include <string>
+
+namespace figcone::shoal::detail {
+
+TreeBuilder::TreeBuilder()
+    : rootNode_{makeTreeRoot()}
+    , nodeStack_{rootNode_.get()}
+{
+}
+
+void TreeBuilder::onNodeBegin(std::string_view name, const StreamPosition& position)
+{
+    nodeStack_.push_back(&nodeStack_.back()->asItem().addNode(std::string{name}, position));
+}
+
+void TreeBuilder::onNodeListBegin(std::string_view name, const StreamPosition& position)
+{
+    nodeStack_.push_back(&nodeStack_.back()->asItem().addNodeList(std::string{name}, position));
+}
+
+void TreeBuilder::onListElement(const StreamPosition& position)
+{
+    nodeStack_.push_back(&nodeStack_.back()->asList().emplaceBack(position));
+}
+
+// Param positions aren't resolved, so the parsing doesn't index the lines of the input unless there's an error
+void TreeBuilder::onParam(std::string_view name, std::string_view value, const ParamPosition&)
+{
+    nodeStack_.back()->asItem().addParam(std::string{name}, std::string{value});
+}
+
+void TreeBuilder::onParamList(
+        std::string_view name,
+        const std::vector<std::string_view>& valueList,
+        const ParamPosition&)
+{
+    nodeStack_.back()->asItem().addParamList(
+            std::string{name},
+            std::vector<std::string>{valueList.begin(), valueList.end()});
+}
+
+void TreeBuilder::onNodeEnd()
+{
+    Expects(nodeStack_.size() > 1);
+    nodeStack_.pop_back();
+}
+
+Tree TreeBuilder::release()
+{
+    nodeStack_.clear();
+    return Tree{std::move(rootNode_)};
+}
+
+} //namespace figcone::shoal::detail
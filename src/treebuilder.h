@@ -0,0 +1,29 @@
+#pragma once
+#include <figcone_shoal/ieventhandler.h>
+#include <figcone_tree/tree.h>
+#include <memory>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+class TreeBuilder : public IEventHandler {
+public:
+    TreeBuilder();
+    void onNodeBegin(std::string_view name, const StreamPosition& position) override;
+    void onNodeListBegin(std::string_view name, const StreamPosition& position) override;
+    void onListElement(const StreamPosition& position) override;
+    void onParam(std::string_view name, std::string_view value, const ParamPosition& position) override;
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const ParamPosition& position) override;
+    void onNodeEnd() override;
+
+    Tree release();
+
+private:
+    std::unique_ptr<TreeNode> rootNode_;
+    std::vector<TreeNode*> nodeStack_;
+};
+
+} //namespace figcone::shoal::detail
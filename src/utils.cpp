@@ -1,28 +1,58 @@
 #include "utils.h"
+#include "arena.h"
+#include "charscan.h"
+#include "charset.h"
 #include "stream.h"
-#include <figcone_tree/errors.h>
 #include <sfun/string_utils.h>
 #include <gsl/util>
-#include <algorithm>
 
 namespace figcone::shoal::detail {
 
-bool isBlank(const std::string& str)
+namespace {
+constexpr auto whitespaceChars = CharSet{" \t\n\v\f\r"};
+constexpr auto blankChars = CharSet{" \t\v\f"};
+
+std::string_view readUntil(Stream& stream, const CharSet& stopChars)
+{
+    auto result = ArenaStringBuilder{stream.arena()};
+    while (!stream.atEnd()) {
+        result.append(stream.readSpan(stopChars));
+        if (stream.atEnd() || stopChars.contains(stream.peekChar()))
+            break;
+        result.push_back(stream.readChar());
+    }
+    return result.release();
+}
+} //namespace
+
+bool isBlank(std::string_view str)
+{
+    const auto end = str.data() + str.size();
+    return findFirstNotOf(str.data(), end, whitespaceChars) == end;
+}
+
+std::string_view trim(std::string_view str)
 {
-    return std::all_of(str.begin(), str.end(), sfun::isspace);
+    const auto end = str.data() + str.size();
+    const auto first = findFirstNotOf(str.data(), end, whitespaceChars);
+    auto last = end;
+    while (last != first && whitespaceChars.contains(*(last - 1)))
+        --last;
+    return {first, static_cast<std::size_t>(last - first)};
 }
 
 void skipLine(Stream& stream)
 {
     while (!stream.atEnd())
-        if (stream.read().front() == '\n')
+        if (stream.readChar() == '\n')
             return;
 }
 
 void skipWhitespace(Stream& stream, bool withNewLine)
 {
     while (!stream.atEnd()) {
-        const auto nextChar = stream.peek().front();
+        stream.skipWhile(blankChars);
+        const auto nextChar = stream.peekChar();
         if (!withNewLine && nextChar == '\n')
             return;
 
@@ -33,45 +63,26 @@ void skipWhitespace(Stream& stream, bool withNewLine)
     }
 }
 
-std::string readUntil(Stream& stream, std::function<bool(char)> stopPred)
+std::string_view readUntil(Stream& stream, std::string_view stopChars)
 {
-    auto result = std::string{};
-    while (!stream.atEnd()) {
-        if (stopPred(stream.peek().front()))
-            return result;
-        result += stream.read();
-    }
-    return result;
+    return readUntil(stream, CharSet{stopChars});
 }
 
-std::string readUntil(Stream& stream, const std::string& stopChars)
+std::string_view readWord(Stream& stream, std::string_view stopChars)
 {
-    return readUntil(
-            stream,
-            [&stopChars](char ch)
-            {
-                return stopChars.find(ch) != std::string::npos;
-            });
-}
-
-std::string readWord(Stream& stream, const std::string& stopChars)
-{
-    return readUntil(
-            stream,
-            [&stopChars](char ch)
-            {
-                return sfun::isspace(ch) || stopChars.find(ch) != std::string::npos;
-            });
+    auto stopCharSet = CharSet{stopChars};
+    stopCharSet.add(whitespaceChars.chars());
+    return readUntil(stream, stopCharSet);
 }
 
-std::optional<std::string> readQuotedString(Stream& stream)
+Expected<std::optional<std::string_view>> readQuotedString(Stream& stream)
 {
     if (stream.atEnd())
-        return {};
+        return std::nullopt;
 
-    const auto quotationMark = stream.peek().front();
+    const auto quotationMark = stream.peekChar();
     if (quotationMark != '\'' && quotationMark != '"' && quotationMark != '`')
-        return {};
+        return std::nullopt;
 
     stream.skipComments(false);
     const auto restoreSkipOnExit = gsl::final_action(
@@ -79,20 +90,24 @@ std::optional<std::string> readQuotedString(Stream& stream)
             {
                 stream.skipComments(true);
             });
-    const auto pos = stream.position();
+    const auto offset = stream.offset();
     stream.skip(1);
 
-    if (stream.peek() == "\n")
+    if (stream.peekChar() == '\n')
         stream.skipLineSeparator();
 
-    auto result = std::string{};
+    const auto stopChars = CharSet{std::string_view{&quotationMark, 1}};
+    auto result = ArenaStringBuilder{stream.arena()};
     while (!stream.atEnd()) {
-        const auto ch = stream.read().front();
+        result.append(stream.readSpan(stopChars));
+        if (stream.atEnd())
+            break;
+        const auto ch = stream.readChar();
         if (ch == quotationMark)
-            return result;
-        result += ch;
+            return result.release();
+        result.push_back(ch);
     }
-    throw ConfigError{"String isn't closed", pos};
+    return ParseError{"String isn't closed", stream.position(offset)};
 }
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+} //namespace figcone::shoal::detail
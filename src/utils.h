@@ -1,17 +1,35 @@
 #pragma once
-#include <functional>
+#include <figcone_shoal/parseresult.h>
+#include <figcone_tree/errors.h>
 #include <optional>
-#include <string>
+#include <string_view>
+#include <utility>
 
 namespace figcone::shoal::detail {
 class Stream;
 
-bool isBlank(const std::string& str);
+bool isBlank(std::string_view str);
+std::string_view trim(std::string_view str);
 void skipLine(Stream& stream);
 void skipWhitespace(Stream& stream, bool withNewLine = true);
-std::string readUntil(Stream& stream, std::function<bool(char)> stopPred);
-std::string readUntil(Stream& stream, const std::string& stopChars = {});
-std::string readWord(Stream& stream, const std::string& stopChars = {});
-std::optional<std::string> readQuotedString(Stream& stream);
+// Read strings are stored in the stream's arena and stay valid until the end of the parsing
+std::string_view readUntil(Stream& stream, std::string_view stopChars = {});
+std::string_view readWord(Stream& stream, std::string_view stopChars = {});
+Expected<std::optional<std::string_view>> readQuotedString(Stream& stream);
 
-} //namespace figcone::shoal::detail
\ No newline at end of file
+// Reports the error of the parser core by throwing ConfigError, for the readers that don't return errors
+template<typename T>
+T valueOrThrow(Expected<T> result)
+{
+    if (!result)
+        throw ConfigError{result.error().message, result.error().position};
+    return std::move(result).value();
+}
+
+inline void valueOrThrow(const Expected<void>& result)
+{
+    if (!result)
+        throw ConfigError{result.error().message, result.error().position};
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,82 @@
+#include "workstealingpool.h"
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace figcone::shoal::detail {
+
+namespace {
+
+class TaskRange {
+public:
+    TaskRange(std::size_t begin, std::size_t end)
+        : begin_{begin}
+        , end_{end}
+    {
+    }
+
+    std::optional<std::size_t> popFront()
+    {
+        auto lock = std::lock_guard{mutex_};
+        if (begin_ == end_)
+            return std::nullopt;
+        return begin_++;
+    }
+
+    std::optional<std::size_t> popBack()
+    {
+        auto lock = std::lock_guard{mutex_};
+        if (begin_ == end_)
+            return std::nullopt;
+        return --end_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::size_t begin_;
+    std::size_t end_;
+};
+
+} //namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t threadCount)
+    : threadCount_{std::max(threadCount, std::size_t{1})}
+{
+}
+
+std::size_t WorkStealingPool::threadCount() const
+{
+    return threadCount_;
+}
+
+void WorkStealingPool::run(std::size_t taskCount, const Task& task)
+{
+    const auto threadCount = std::min(threadCount_, std::max(taskCount, std::size_t{1}));
+    auto ranges = std::vector<std::unique_ptr<TaskRange>>{};
+    for (auto i = std::size_t{}; i < threadCount; ++i)
+        ranges.push_back(std::make_unique<TaskRange>(taskCount * i / threadCount, taskCount * (i + 1) / threadCount));
+
+    auto runThread = [&](std::size_t threadIndex)
+    {
+        while (auto taskIndex = ranges[threadIndex]->popFront())
+            task(threadIndex, *taskIndex);
+
+        for (auto i = std::size_t{1}; i < threadCount; ++i) {
+            auto& victimRange = *ranges[(threadIndex + i) % threadCount];
+            while (auto taskIndex = victimRange.popBack())
+                task(threadIndex, *taskIndex);
+        }
+    };
+
+    auto threads = std::vector<std::future<void>>{};
+    for (auto i = std::size_t{1}; i < threadCount; ++i)
+        threads.push_back(std::async(std::launch::async, runThread, i));
+    runThread(0);
+    for (auto& thread : threads)
+        thread.get();
+}
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace figcone::shoal::detail {
+
+// Runs the tasks with indices [0, taskCount) on several threads.
+// Each thread gets a contiguous part of the index range and processes it in order, a thread
+// that has finished its part steals the tasks from the end of the parts of other threads.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(std::size_t threadIndex, std::size_t taskIndex)>;
+
+    explicit WorkStealingPool(std::size_t threadCount);
+    std::size_t threadCount() const;
+    // Returns when all tasks are finished, rethrows the first exception thrown by a task
+    void run(std::size_t taskCount, const Task& task);
+
+private:
+    std::size_t threadCount_;
+};
+
+} //namespace figcone::shoal::detail
@@ -0,0 +1,351 @@
+#include "synthconfig.h"
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace shoal_synth {
+
+namespace {
+
+constexpr auto flushSize = std::size_t{1024 * 1024};
+constexpr auto multilineStringChance = 0.05;
+constexpr auto blankLineChance = 0.05;
+constexpr auto words = std::array<std::string_view, 16>{
+        "server",
+        "client",
+        "cache",
+        "worker",
+        "queue",
+        "log",
+        "storage",
+        "proxy",
+        "route",
+        "user",
+        "auth",
+        "timeout",
+        "limit",
+        "path",
+        "host",
+        "port"};
+constexpr auto unquotedChars = std::string_view{"abcdefghijklmnopqrstuvwxyz0123456789_."};
+// Quoted strings also contain the characters of the format's syntax, which are ignored there
+constexpr auto quotedChars = std::string_view{"abcdefghijklmnopqrstuvwxyz0123456789 ,;#-=[]"};
+constexpr auto quotes = std::string_view{"'\"`"};
+
+// splitmix64, it doesn't depend on the standard library implementation, so the output is the same on every platform
+class Random {
+public:
+    explicit Random(std::uint64_t seed)
+        : state_{seed}
+    {
+    }
+
+    std::uint64_t next()
+    {
+        auto result = (state_ += 0x9e3779b97f4a7c15ull);
+        result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9ull;
+        result = (result ^ (result >> 27)) * 0x94d049bb133111ebull;
+        return result ^ (result >> 31);
+    }
+
+    // Uniform in [min, max]
+    int range(int min, int max)
+    {
+        return min + static_cast<int>(next() % static_cast<std::uint64_t>(max - min + 1));
+    }
+
+    int around(int average)
+    {
+        if (average <= 0)
+            return 0;
+        return range(average - average / 2, average + average / 2);
+    }
+
+    bool chance(double probability)
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53 < probability;
+    }
+
+    template<typename T>
+    auto pick(const T& items)
+    {
+        return items[next() % items.size()];
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+std::string_view lineSeparator(LineEnding lineEnding)
+{
+    switch (lineEnding) {
+    case LineEnding::CRLF:
+        return "\r\n";
+    case LineEnding::CR:
+        return "\r";
+    default:
+        return "\n";
+    }
+}
+
+class ConfigWriter {
+    struct OpenNode {
+        std::string name;
+        bool isList;
+    };
+
+public:
+    ConfigWriter(const SynthOptions& options, std::ostream& output)
+        : options_{options}
+        , output_{output}
+        , random_{options.seed}
+        , lineSeparator_{lineSeparator(options.lineEnding)}
+    {
+    }
+
+    void write()
+    {
+        const auto paramsShare =
+                options_.depth > 0 ? static_cast<double>(options_.paramsPerNode) /
+                                             std::max(1, options_.paramsPerNode + options_.fanout)
+                                   : 1.0;
+        while (writtenSize_ + buffer_.size() < options_.targetSize) {
+            closeTo(0);
+            if (random_.chance(paramsShare))
+                writeParam(0);
+            else
+                writeChildNode(0);
+        }
+        flush();
+    }
+
+private:
+    // Params are written before and after the child nodes, which are left open and closed by the next item
+    void writeNodeContent(int level)
+    {
+        const auto paramsCount = std::max(1, random_.around(options_.paramsPerNode));
+        const auto childrenCount = level < options_.depth ? random_.around(options_.fanout) : 0;
+        const auto paramsAfterChildrenCount = childrenCount ? random_.range(0, paramsCount / 3) : 0;
+
+        for (auto i = 0; i < paramsCount - paramsAfterChildrenCount; ++i)
+            writeParam(level);
+        for (auto i = 0; i < childrenCount; ++i) {
+            closeTo(level);
+            writeChildNode(level);
+        }
+        for (auto i = 0; i < paramsAfterChildrenCount; ++i) {
+            closeTo(level);
+            writeParam(level);
+        }
+    }
+
+    void writeChildNode(int level)
+    {
+        if (random_.chance(blankLineChance))
+            endLine();
+        writeComment(level);
+
+        const auto isList = random_.chance(options_.nodeLists);
+        auto name = std::string{random_.pick(words)} + "_" + std::to_string(nodeCount_++);
+        indent(level);
+        buffer_ += "#" + name + ":";
+        writeTrailingComment();
+        endLine();
+        openNodes_.push_back({std::move(name), isList});
+
+        if (!isList) {
+            writeNodeContent(level + 1);
+            return;
+        }
+        // '###' also closes the nodes left open by the previous element, unless one of them is a node list,
+        // which would get the new element
+        const auto elementsCount = std::max(1, random_.around(options_.listLength));
+        for (auto i = 0; i < elementsCount; ++i) {
+            const auto listIndex = static_cast<std::size_t>(level);
+            if (std::any_of(
+                        openNodes_.begin() + static_cast<std::ptrdiff_t>(listIndex) + 1,
+                        openNodes_.end(),
+                        [](const OpenNode& node)
+                        {
+                            return node.isList;
+                        }))
+                closeTo(level + 1);
+            openNodes_.resize(listIndex + 1);
+            indent(level);
+            buffer_ += "###";
+            writeTrailingComment();
+            endLine();
+            writeNodeContent(level + 1);
+        }
+    }
+
+    // Closes the open nodes above the level with a random choice of '-', '--name' or '---' tokens
+    void closeTo(int level)
+    {
+        const auto targetSize = static_cast<std::size_t>(level);
+        if (openNodes_.size() <= targetSize)
+            return;
+
+        if (level == 0 && random_.chance(1.0 / 3)) {
+            buffer_ += "---";
+            endLine();
+            openNodes_.clear();
+        }
+        else if (random_.chance(0.5)) {
+            indent(level);
+            buffer_ += "--" + openNodes_[targetSize].name;
+            endLine();
+            openNodes_.resize(targetSize);
+        }
+        else {
+            while (openNodes_.size() > targetSize) {
+                openNodes_.pop_back();
+                indent(static_cast<int>(openNodes_.size()));
+                buffer_ += "-";
+                endLine();
+            }
+        }
+    }
+
+    void writeParam(int level)
+    {
+        writeComment(level);
+        indent(level);
+        buffer_ += std::string{random_.pick(words)} + std::to_string(paramCount_++) + " = ";
+        if (!random_.chance(options_.paramLists)) {
+            buffer_ += makeValue(true);
+            writeTrailingComment();
+            endLine();
+            return;
+        }
+
+        const auto valuesCount = std::max(1, random_.around(options_.listLength));
+        if (random_.chance(0.5)) {
+            buffer_ += "[";
+            endLine();
+            for (auto i = 0; i < valuesCount; ++i) {
+                indent(level + 1);
+                buffer_ += makeValue(false);
+                if (i + 1 < valuesCount)
+                    buffer_ += ",";
+                endLine();
+            }
+            indent(level);
+            buffer_ += "]";
+            endLine();
+            return;
+        }
+
+        // Lists of several values can be written without the brackets
+        const auto hasBrackets = valuesCount == 1 || random_.chance(0.5);
+        if (hasBrackets)
+            buffer_ += "[";
+        for (auto i = 0; i < valuesCount; ++i) {
+            if (i > 0)
+                buffer_ += ", ";
+            buffer_ += makeValue(false);
+        }
+        if (hasBrackets)
+            buffer_ += "]";
+        writeTrailingComment();
+        endLine();
+    }
+
+    std::string makeValue(bool canBeMultiline)
+    {
+        const auto length = std::max(1, random_.around(options_.valueLength));
+        auto value = std::string{};
+        if (!random_.chance(options_.quotedValues)) {
+            for (auto i = 0; i < length; ++i)
+                value += random_.pick(unquotedChars);
+            return value;
+        }
+
+        const auto quote = random_.pick(quotes);
+        const auto newLinePos = canBeMultiline && random_.chance(multilineStringChance) ? length / 2 : -1;
+        value += quote;
+        for (auto i = 0; i < length; ++i) {
+            if (i == newLinePos)
+                value += lineSeparator_;
+            value += random_.pick(quotedChars);
+        }
+        value += quote;
+        return value;
+    }
+
+    void writeComment(int level)
+    {
+        if (!random_.chance(options_.commentDensity / 2))
+            return;
+        indent(level);
+        buffer_ += ";";
+        writeCommentText();
+        endLine();
+    }
+
+    void writeTrailingComment()
+    {
+        if (!random_.chance(options_.commentDensity / 2))
+            return;
+        buffer_ += " ;";
+        writeCommentText();
+    }
+
+    void writeCommentText()
+    {
+        const auto wordsCount = random_.range(1, 8);
+        for (auto i = 0; i < wordsCount; ++i) {
+            buffer_ += " ";
+            buffer_ += random_.pick(words);
+        }
+    }
+
+    void indent(int level)
+    {
+        buffer_.append(static_cast<std::size_t>(level) * 2, ' ');
+    }
+
+    void endLine()
+    {
+        buffer_ += lineSeparator_;
+        if (buffer_.size() >= flushSize)
+            flush();
+    }
+
+    void flush()
+    {
+        output_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        writtenSize_ += buffer_.size();
+        buffer_.clear();
+    }
+
+private:
+    const SynthOptions& options_;
+    std::ostream& output_;
+    Random random_;
+    std::string_view lineSeparator_;
+    std::string buffer_;
+    std::uint64_t writtenSize_ = 0;
+    std::vector<OpenNode> openNodes_;
+    std::uint64_t nodeCount_ = 0;
+    std::uint64_t paramCount_ = 0;
+};
+
+} //namespace
+
+void generateConfig(const SynthOptions& options, std::ostream& output)
+{
+    auto writer = ConfigWriter{options, output};
+    writer.write();
+}
+
+std::string generateConfig(const SynthOptions& options)
+{
+    auto output = std::ostringstream{};
+    generateConfig(options, output);
+    return output.str();
+}
+
+} //namespace shoal_synth
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace shoal_synth {
+
+enum class LineEnding {
+    LF,
+    CRLF,
+    CR
+};
+
+// Shape of a generated config. Counts are averages, every node draws its own values around them.
+struct SynthOptions {
+    std::uint64_t seed = 1;
+    // Top-level sections are written until the output reaches this size
+    std::uint64_t targetSize = 1024 * 1024;
+    // Nesting depth of the config nodes, 0 generates only top-level params
+    int depth = 3;
+    // Child nodes of every node
+    int fanout = 3;
+    int paramsPerNode = 6;
+    // Elements of the node lists and values of the param lists
+    int listLength = 4;
+    // Length of the param values in characters
+    int valueLength = 10;
+    // Share of the lines that are preceded by a comment or have a trailing comment
+    double commentDensity = 0.1;
+    LineEnding lineEnding = LineEnding::LF;
+    // Share of the quoted values, the quotes are picked from ', " and ` in equal proportions
+    double quotedValues = 0.3;
+    // Share of the child nodes that are node lists
+    double nodeLists = 0.25;
+    // Share of the params that are lists, a half of them is written on multiple lines
+    double paramLists = 0.15;
+};
+
+// Writes a valid shoal document, which depends only on the options, so the same seed always gives the same config.
+// The output is written in blocks, so its size isn't limited by the available memory.
+// It uses all the constructs of the format: nested nodes, node lists, param lists on one or multiple lines,
+// quoted strings spanning multiple lines, comments and '-', '--name' and '---' closing tokens.
+void generateConfig(const SynthOptions& options, std::ostream& output);
+std::string generateConfig(const SynthOptions& options);
+
+} //namespace shoal_synth
@@ -0,0 +1,320 @@
+// Generated by shoalgen from a config schema, don't edit it manually
+#pragma once
+#include <figcone_shoal/structreader.h>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_structreader {
+
+struct Endpoint {
+    std::string host;
+    int port{};
+};
+
+struct Tls {
+    std::string certificate;
+    std::optional<bool> verifyPeer;
+};
+
+struct ServerConfig {
+    std::string name;
+    std::optional<int> threads;
+    bool verbose{};
+    double timeout{};
+    std::vector<std::string> tags;
+    std::optional<std::vector<unsigned int>> ports;
+    Endpoint endpoint;
+    std::vector<Endpoint> replicas;
+    std::optional<Tls> tls;
+};
+
+class ServerConfigReader : public figcone::shoal::StructReaderBase {
+    enum FrameType {
+        EndpointItem,
+        EndpointList,
+        TlsItem,
+        ServerConfigItem,
+    };
+
+public:
+    explicit ServerConfigReader(::test_structreader::ServerConfig& config)
+    {
+        beginFrame(ServerConfigItem, &config, {});
+    }
+
+    // Checks the root struct after the parsing is finished
+    void finish()
+    {
+        endFrame(popFrame());
+    }
+
+    void onNodeBegin(std::string_view name, const figcone::StreamPosition& position) override
+    {
+        readNode(name, false, position);
+    }
+
+    void onNodeListBegin(std::string_view name, const figcone::StreamPosition& position) override
+    {
+        readNode(name, true, position);
+    }
+
+    void onListElement(const figcone::StreamPosition& position) override
+    {
+        switch (currentFrame().type) {
+        case EndpointList:
+            beginListElement<::test_structreader::Endpoint>(EndpointItem, position);
+            break;
+        }
+    }
+
+    void onParam(std::string_view name, std::string_view value, const figcone::shoal::ParamPosition& position) override
+    {
+        readParam(name, value, position);
+    }
+
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const figcone::shoal::ParamPosition& position) override
+    {
+        readParam(name, valueList, position);
+    }
+
+    void onNodeEnd() override
+    {
+        endFrame(popFrame());
+    }
+
+private:
+    void readNode(std::string_view name, bool isList, const figcone::StreamPosition& position)
+    {
+        auto& frame = currentFrame();
+        switch (frame.type) {
+        case ServerConfigItem:
+            readServerConfigNode(
+                    *static_cast<::test_structreader::ServerConfig*>(frame.object),
+                    frame.readFields,
+                    name,
+                    isList,
+                    position);
+            return;
+        }
+        throwUnknownNode(name, position);
+    }
+
+    template<typename TValue>
+    void readParam(std::string_view name, const TValue& value, const figcone::shoal::ParamPosition& position)
+    {
+        auto& frame = currentFrame();
+        switch (frame.type) {
+        case EndpointItem:
+            readEndpointParam(
+                    *static_cast<::test_structreader::Endpoint*>(frame.object),
+                    frame.readFields,
+                    name,
+                    value,
+                    position);
+            return;
+        case TlsItem:
+            readTlsParam(
+                    *static_cast<::test_structreader::Tls*>(frame.object),
+                    frame.readFields,
+                    name,
+                    value,
+                    position);
+            return;
+        case ServerConfigItem:
+            readServerConfigParam(
+                    *static_cast<::test_structreader::ServerConfig*>(frame.object),
+                    frame.readFields,
+                    name,
+                    value,
+                    position);
+            return;
+        }
+        throwUnknownParam(name, position);
+    }
+
+    void endFrame(const Frame& frame)
+    {
+        switch (frame.type) {
+        case EndpointItem:
+            if (!(frame.readFields & (std::uint64_t{1} << 0)))
+                throwMissingParam("host", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 1)))
+                throwMissingParam("port", frame.position);
+            break;
+        case TlsItem:
+            if (!(frame.readFields & (std::uint64_t{1} << 0)))
+                throwMissingParam("certificate", frame.position);
+            break;
+        case ServerConfigItem:
+            if (!(frame.readFields & (std::uint64_t{1} << 0)))
+                throwMissingParam("name", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 2)))
+                throwMissingParam("verbose", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 3)))
+                throwMissingParam("timeout", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 4)))
+                throwMissingParam("tags", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 6)))
+                throwMissingNode("endpoint", frame.position);
+            if (!(frame.readFields & (std::uint64_t{1} << 7)))
+                throwMissingNode("replicas", frame.position);
+            break;
+        }
+    }
+
+    template<typename TValue>
+    static void readEndpointParam(
+            ::test_structreader::Endpoint& object,
+            std::uint64_t& readFields,
+            std::string_view name,
+            const TValue& value,
+            const figcone::shoal::ParamPosition& position)
+    {
+        switch (figcone::shoal::structKeyHash(name, 0u) & 1u) {
+        case 0u:
+            if (name == "port") {
+                readField(object.port, readFields, std::uint64_t{1} << 1, name, value, position);
+                return;
+            }
+            break;
+        case 1u:
+            if (name == "host") {
+                readField(object.host, readFields, std::uint64_t{1} << 0, name, value, position);
+                return;
+            }
+            break;
+        }
+        throwUnknownParam(name, position);
+    }
+
+    template<typename TValue>
+    static void readTlsParam(
+            ::test_structreader::Tls& object,
+            std::uint64_t& readFields,
+            std::string_view name,
+            const TValue& value,
+            const figcone::shoal::ParamPosition& position)
+    {
+        switch (figcone::shoal::structKeyHash(name, 0u) & 1u) {
+        case 0u:
+            if (name == "certificate") {
+                readField(object.certificate, readFields, std::uint64_t{1} << 0, name, value, position);
+                return;
+            }
+            break;
+        case 1u:
+            if (name == "verifyPeer") {
+                readField(object.verifyPeer, readFields, std::uint64_t{1} << 1, name, value, position);
+                return;
+            }
+            break;
+        }
+        throwUnknownParam(name, position);
+    }
+
+    void readServerConfigNode(
+            ::test_structreader::ServerConfig& object,
+            std::uint64_t& readFields,
+            std::string_view name,
+            bool isList,
+            const figcone::StreamPosition& position)
+    {
+        switch (figcone::shoal::structKeyHash(name, 2u) & 15u) {
+        case 0u:
+            if (name == "replicas") {
+                beginNodeList(EndpointList, object.replicas, readFields, std::uint64_t{1} << 7, name, isList, position);
+                return;
+            }
+            break;
+        case 9u:
+            if (name == "endpoint") {
+                beginNode(EndpointItem, object.endpoint, readFields, std::uint64_t{1} << 6, name, isList, position);
+                return;
+            }
+            break;
+        case 11u:
+            if (name == "tls") {
+                beginNode(TlsItem, object.tls, readFields, std::uint64_t{1} << 8, name, isList, position);
+                return;
+            }
+            break;
+        }
+        throwUnknownNode(name, position);
+    }
+
+    template<typename TValue>
+    static void readServerConfigParam(
+            ::test_structreader::ServerConfig& object,
+            std::uint64_t& readFields,
+            std::string_view name,
+            const TValue& value,
+            const figcone::shoal::ParamPosition& position)
+    {
+        switch (figcone::shoal::structKeyHash(name, 2u) & 15u) {
+        case 4u:
+            if (name == "name") {
+                readField(object.name, readFields, std::uint64_t{1} << 0, name, value, position);
+                return;
+            }
+            break;
+        case 5u:
+            if (name == "tags") {
+                readField(object.tags, readFields, std::uint64_t{1} << 4, name, value, position);
+                return;
+            }
+            break;
+        case 7u:
+            if (name == "ports") {
+                readField(object.ports, readFields, std::uint64_t{1} << 5, name, value, position);
+                return;
+            }
+            break;
+        case 8u:
+            if (name == "verbose") {
+                readField(object.verbose, readFields, std::uint64_t{1} << 2, name, value, position);
+                return;
+            }
+            break;
+        case 10u:
+            if (name == "timeout") {
+                readField(object.timeout, readFields, std::uint64_t{1} << 3, name, value, position);
+                return;
+            }
+            break;
+        case 13u:
+            if (name == "threads") {
+                readField(object.threads, readFields, std::uint64_t{1} << 1, name, value, position);
+                return;
+            }
+            break;
+        }
+        throwUnknownParam(name, position);
+    }
+};
+
+inline ServerConfig parseServerConfig(std::string_view data)
+{
+    auto config = ServerConfig{};
+    auto reader = ServerConfigReader{config};
+    figcone::shoal::Parser{}.parse(data, reader);
+    reader.finish();
+    return config;
+}
+
+inline ServerConfig parseServerConfigFile(const std::filesystem::path& path)
+{
+    auto config = ServerConfig{};
+    auto reader = ServerConfigReader{config};
+    figcone::shoal::Parser{}.parseFile(path, reader);
+    reader.finish();
+    return config;
+}
+
+} //namespace test_structreader
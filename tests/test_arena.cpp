@@ -0,0 +1,69 @@
+#include <arena.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+
+namespace test_arena {
+
+using figcone::shoal::detail::Arena;
+using figcone::shoal::detail::ArenaAllocator;
+using figcone::shoal::detail::ArenaStringBuilder;
+using figcone::shoal::detail::ArenaVector;
+
+TEST(TestArena, StringBuilder)
+{
+    auto arena = Arena{};
+    auto builder = ArenaStringBuilder{arena};
+    builder.append("Hello");
+    builder.push_back(' ');
+    builder.append("world");
+    const auto hello = builder.release();
+
+    builder.append(std::string(10000, 'x'));
+    const auto longString = builder.release();
+    const auto empty = builder.release();
+
+    EXPECT_EQ(hello, "Hello world");
+    EXPECT_EQ(longString, std::string(10000, 'x'));
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(TestArena, BuilderGrowsInPlace)
+{
+    auto arena = Arena{};
+    auto builder = ArenaStringBuilder{arena};
+    for (auto i = 0; i < 1000; ++i)
+        builder.push_back('a');
+    EXPECT_EQ(builder.release(), std::string(1000, 'a'));
+    EXPECT_EQ(arena.allocatedSize(), 4096u);
+}
+
+TEST(TestArena, AlignedAllocationAfterBlockOfUnalignedSize)
+{
+    auto arena = Arena{};
+    auto builder = ArenaStringBuilder{arena};
+    builder.append(std::string(100001, 'x'));
+    const auto name = builder.release();
+    ASSERT_EQ(arena.allocatedSize(), 100001u);
+
+    // The block is full, so the allocation must be placed in a new one
+    const auto data = arena.allocate(sizeof(std::int64_t), alignof(std::int64_t));
+    EXPECT_GT(arena.allocatedSize(), 100001u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data) % alignof(std::int64_t), 0u);
+    EXPECT_EQ(name, std::string(100001, 'x'));
+}
+
+TEST(TestArena, Vector)
+{
+    auto arena = Arena{};
+    auto vec = ArenaVector<std::int64_t>{ArenaAllocator<std::int64_t>{arena}};
+    for (auto i = 0; i < 10000; ++i)
+        vec.push_back(i);
+
+    ASSERT_EQ(vec.size(), 10000u);
+    EXPECT_EQ(vec.front(), 0);
+    EXPECT_EQ(vec.back(), 9999);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % alignof(std::int64_t), 0u);
+}
+
+} //namespace test_arena
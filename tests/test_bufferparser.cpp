@@ -0,0 +1,173 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string_view>
+
+namespace test_bufferparser {
+
+auto parse(std::string_view str)
+{
+    auto parser = figcone::shoal::Parser{};
+    return parser.parse(str);
+}
+
+std::string parseError(std::string_view str)
+{
+    auto parser = figcone::shoal::Parser{};
+    try {
+        parser.parse(str);
+    }
+    catch (const figcone::ConfigError& e) {
+        return e.what();
+    }
+    return {};
+}
+
+std::string parseStreamError(std::string_view str)
+{
+    auto input = std::stringstream{std::string{str}};
+    auto parser = figcone::shoal::Parser{};
+    try {
+        parser.parse(input);
+    }
+    catch (const figcone::ConfigError& e) {
+        return e.what();
+    }
+    return {};
+}
+
+TEST(TestBufferParser, Nodes)
+{
+    auto result = parse(R"(
+        foo = 5 ;comment
+        bar = 'test' 
+        #a:
+          testInt = 10
+          testList = [1,
+                      2]
+        -
+        #b:
+        ###
+          testStr = "hello world"
+        ###
+          testStr = `Hello
+world`
+    )");
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 2);
+    EXPECT_EQ(tree.param("foo").value(), "5");
+    EXPECT_EQ(tree.param("bar").value(), "test");
+    ASSERT_EQ(tree.nodesCount(), 2);
+    auto& aNode = tree.node("a").asItem();
+    ASSERT_EQ(aNode.paramsCount(), 2);
+    EXPECT_EQ(aNode.param("testInt").value(), "10");
+    EXPECT_EQ(aNode.param("testList").valueList(), (std::vector<std::string>{"1", "2"}));
+    auto& bNode = tree.node("b").asList();
+    ASSERT_EQ(bNode.size(), 2);
+    EXPECT_EQ(bNode.at(0).asItem().param("testStr").value(), "hello world");
+    EXPECT_EQ(bNode.at(1).asItem().param("testStr").value(), "Hello\nworld");
+}
+
+TEST(TestBufferParser, NotNullTerminatedBuffer)
+{
+    const auto data = std::string{"foo = 1\nbar = 23"};
+    auto result = parse(std::string_view{data.data(), data.size() - 1});
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 2);
+    EXPECT_EQ(tree.param("foo").value(), "1");
+    EXPECT_EQ(tree.param("bar").value(), "2");
+}
+
+TEST(TestBufferParser, SameErrorsAsStreamParser)
+{
+    const auto configs = std::vector<std::string_view>{
+            "foo = 5\n#a:\n  testInt = 10\n--b\n",
+            "foo = 5\r\n#a: test\r\n",
+            "foo = 5\r\t bar\r\n",
+            "foo = [1,\n  2,\n  ]\n",
+            "#list:\n###  error\n",
+            "\tfoo = \"bar\n",
+            "foo = \n"};
+
+    for (const auto config : configs) {
+        const auto error = parseError(config);
+        EXPECT_FALSE(error.empty());
+        EXPECT_EQ(error, parseStreamError(config));
+    }
+}
+
+std::string describeParams(const figcone::TreeNode& node)
+{
+    auto result = std::string{};
+    const auto& item = node.asItem();
+    for (const auto& name : {"a", "b", "c"}) {
+        if (!item.hasParam(name))
+            continue;
+        const auto& param = item.param(name);
+        result += std::string{name} + (param.isList() ? "[]" : "") + ":";
+        if (param.isItem())
+            result += "<" + param.value() + ">";
+        else
+            for (const auto& value : param.valueList())
+                result += "<" + value + ">";
+    }
+    return result;
+}
+
+TEST(TestBufferParser, SameParamsAsStreamParser)
+{
+    const auto configs = std::vector<std::string_view>{
+            "a = 1\nb=2\r\nc =  3  ",
+            "a = hello world ;comment\nb = 'x;y' ;comment\r\nc=`z`",
+            "a = 1, 2 ,3\nb = 'x', \"y\" , z\nc = it's",
+            "a-b = 1\na = #x, -y, [z]\nb = k=v\r",
+            "a = ''\nb = '\n multiline'\nc = [1,\n2]",
+            "a = 'x'\t\n\n\nb = y\t;\nc = z;",
+            "a\t= 1\nb =\v2\r\rc = 3\n"};
+
+    for (const auto config : configs) {
+        auto input = std::stringstream{std::string{config}};
+        auto parser = figcone::shoal::Parser{};
+        const auto streamResult = parser.parse(input);
+        const auto result = parse(config);
+        EXPECT_FALSE(describeParams(result.root()).empty());
+        EXPECT_EQ(describeParams(result.root()), describeParams(streamResult.root()));
+    }
+}
+
+TEST(TestBufferParser, SameParamErrorsAsStreamParser)
+{
+    const auto configs = std::vector<std::string_view>{
+            "a b = 1\n",
+            " = 1\n",
+            "a = 1,\n",
+            "a = 1,,2\n",
+            "a = 'x' y\n",
+            "a = 'x\n",
+            "a = ;comment\n",
+            "a ;comment\n= 1"};
+
+    for (const auto config : configs) {
+        const auto error = parseError(config);
+        EXPECT_FALSE(error.empty());
+        EXPECT_EQ(error, parseStreamError(config));
+    }
+}
+
+TEST(TestBufferParser, ErrorPosition)
+{
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parse("foo = 5\n#a:\n  testInt = 10\n--b\n");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, "[line:4, column:2] Can't close unexisting node 'b'");
+            });
+}
+
+} //namespace test_bufferparser
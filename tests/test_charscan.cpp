@@ -0,0 +1,104 @@
+#include <charscan.h>
+#include <structuralindex.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace test_charscan {
+
+using figcone::shoal::detail::CharSet;
+
+const char* findFirstOfReference(const char* first, const char* last, const CharSet& chars, bool isNegated)
+{
+    for (; first != last; ++first)
+        if (chars.contains(*first) != isNegated)
+            return first;
+    return last;
+}
+
+void checkAllRanges(const std::string& data, const CharSet& chars)
+{
+    const auto begin = data.data();
+    const auto end = data.data() + data.size();
+    for (auto offset = std::size_t{}; offset < 40 && offset <= data.size(); ++offset) {
+        for (auto last = begin + offset; last <= end; last += 7) {
+            EXPECT_EQ(
+                    figcone::shoal::detail::findFirstOf(begin + offset, last, chars),
+                    findFirstOfReference(begin + offset, last, chars, false));
+            EXPECT_EQ(
+                    figcone::shoal::detail::findFirstNotOf(begin + offset, last, chars),
+                    findFirstOfReference(begin + offset, last, chars, true));
+        }
+    }
+}
+
+TEST(TestCharScan, FindInRandomData)
+{
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_int_distribution<int>{0, 9};
+    const auto alphabet = std::string{" \t\nab;,=\r\xff"};
+    for (auto i = 0; i < 20; ++i) {
+        auto data = std::string{};
+        for (auto j = 0; j < 200; ++j)
+            data.push_back(distribution(generator) < 8 ? 'x' : alphabet[static_cast<std::size_t>(j) % alphabet.size()]);
+        checkAllRanges(data, CharSet{";\r\n"});
+        checkAllRanges(data, CharSet{" \t"});
+        checkAllRanges(data, CharSet{"\xff"});
+    }
+}
+
+TEST(TestCharScan, FindWithLargeCharSet)
+{
+    const auto data = std::string(100, 'x') + "0123456789abcdefghij" + std::string(100, 'y');
+    checkAllRanges(data, CharSet{"0123456789abcdefghij"});
+    checkAllRanges(data, CharSet{"xyz0123456789abcdefghij"});
+}
+
+TEST(TestCharScan, NotFound)
+{
+    const auto data = std::string(1000, 'x');
+    const auto end = data.data() + data.size();
+    EXPECT_EQ(figcone::shoal::detail::findFirstOf(data.data(), end, CharSet{"\n"}), end);
+    EXPECT_EQ(figcone::shoal::detail::findFirstNotOf(data.data(), end, CharSet{"x"}), end);
+    EXPECT_EQ(figcone::shoal::detail::findFirstOf(data.data(), data.data(), CharSet{"x"}), data.data());
+}
+
+TEST(TestCharScan, MarkCharsInRandomData)
+{
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_int_distribution<int>{0, 9};
+    const auto alphabet = std::string{" \t\nab;,=\r\xff"};
+    const auto chars = CharSet{";=\n\xff"};
+    for (auto size = std::size_t{}; size < 300; size += 13) {
+        auto data = std::string{};
+        for (auto i = std::size_t{}; i < size; ++i)
+            data.push_back(distribution(generator) < 7 ? 'x' : alphabet[i % alphabet.size()]);
+
+        auto masks = std::vector<std::uint64_t>((size + 63) / 64);
+        figcone::shoal::detail::markCharsOf(data.data(), data.data() + data.size(), chars, masks.data());
+        auto expectedMasks = std::vector<std::uint64_t>((size + 63) / 64);
+        for (auto i = std::size_t{}; i < size; ++i)
+            if (chars.contains(data[i]))
+                expectedMasks[i / 64] |= std::uint64_t{1} << (i % 64);
+        EXPECT_EQ(masks, expectedMasks);
+    }
+}
+
+TEST(TestStructuralIndex, Next)
+{
+    const auto data = std::string(70, 'x') + "=" + std::string(100, 'y') + "\n#" + std::string(5, 'z');
+    const auto index = figcone::shoal::detail::StructuralIndex{data};
+    EXPECT_EQ(index.next(0), 70u);
+    EXPECT_EQ(index.next(70), 70u);
+    EXPECT_EQ(index.next(71), 171u);
+    EXPECT_EQ(index.next(172), 172u);
+    EXPECT_EQ(index.next(173), data.size());
+    EXPECT_EQ(index.next(data.size()), data.size());
+
+    const auto emptyIndex = figcone::shoal::detail::StructuralIndex{{}};
+    EXPECT_EQ(emptyIndex.next(0), 0u);
+}
+
+} //namespace test_charscan
@@ -0,0 +1,207 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_compiledconfig {
+
+void expectPosition(const figcone::StreamPosition& position, int line, int column)
+{
+    EXPECT_EQ(position.line, line);
+    EXPECT_EQ(position.column, column);
+}
+
+constexpr auto config = std::string_view{R"(foo = 5
+#a:
+  bar = [1,
+         2]
+  #b:
+    baz = 'x'
+--a
+#list:
+###
+  x = 1
+  #d:
+    y = 2
+###
+  x = 3
+---
+#c:
+  foo = 5
+)"};
+
+TEST(TestCompiledConfig, Nodes)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile(config);
+    const auto compiledConfig = parser.loadCompiled(image);
+
+    const auto root = compiledConfig.root();
+    EXPECT_FALSE(root.isList());
+    EXPECT_EQ(root.nodesCount(), 3u);
+    EXPECT_TRUE(root.hasNode("a"));
+    EXPECT_TRUE(root.hasNode("c"));
+    EXPECT_FALSE(root.hasNode("b"));
+
+    const auto aNode = root.node("a");
+    expectPosition(aNode.position(), 2, 1);
+    ASSERT_EQ(aNode.nodesCount(), 1u);
+    EXPECT_EQ(aNode.node("b").name(), "b");
+
+    const auto listNode = root.node("list");
+    EXPECT_TRUE(listNode.isList());
+    EXPECT_EQ(listNode.nodesCount(), 0u);
+    ASSERT_EQ(listNode.size(), 2u);
+    EXPECT_EQ(listNode.at(0).name(), "list");
+    expectPosition(listNode.at(0).position(), 10, 3);
+    EXPECT_TRUE(listNode.at(0).hasNode("d"));
+    EXPECT_EQ(listNode.at(1).nodesCount(), 0u);
+}
+
+TEST(TestCompiledConfig, Params)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile(config);
+    const auto compiledConfig = parser.loadCompiled(image);
+
+    const auto root = compiledConfig.root();
+    ASSERT_EQ(root.paramsCount(), 1u);
+    const auto fooParam = root.param("foo");
+    EXPECT_FALSE(fooParam.isList());
+    EXPECT_EQ(fooParam.value(), "5");
+    expectPosition(fooParam.position(), 1, 1);
+
+    const auto barParam = root.node("a").param("bar");
+    EXPECT_TRUE(barParam.isList());
+    EXPECT_EQ(barParam.valueList(), (std::vector<std::string_view>{"1", "2"}));
+    EXPECT_EQ(root.node("a").node("b").param("baz").value(), "x");
+    EXPECT_EQ(root.node("list").at(0).node("d").param("y").value(), "2");
+    EXPECT_EQ(root.node("list").at(1).param("x").value(), "3");
+    EXPECT_EQ(root.node("c").param("foo").value(), "5");
+    EXPECT_FALSE(root.node("c").hasParam("bar"));
+}
+
+TEST(TestCompiledConfig, Tree)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile(config);
+    const auto tree = parser.loadCompiled(image).tree();
+
+    const auto& root = tree.root().asItem();
+    ASSERT_EQ(root.paramsCount(), 1);
+    EXPECT_EQ(root.param("foo").value(), "5");
+    ASSERT_EQ(root.nodesCount(), 3);
+
+    const auto& aNode = root.node("a").asItem();
+    EXPECT_EQ(aNode.param("bar").valueList(), (std::vector<std::string>{"1", "2"}));
+    EXPECT_EQ(aNode.node("b").asItem().param("baz").value(), "x");
+
+    const auto& listNode = root.node("list").asList();
+    ASSERT_EQ(listNode.size(), 2);
+    expectPosition(listNode.at(0).position(), 10, 3);
+    EXPECT_EQ(listNode.at(0).asItem().param("x").value(), "1");
+    EXPECT_EQ(listNode.at(0).asItem().node("d").asItem().param("y").value(), "2");
+    EXPECT_EQ(listNode.at(1).asItem().param("x").value(), "3");
+}
+
+TEST(TestCompiledConfig, RepeatedParam)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile("a = 1\nb = 2\na = 3\n");
+    const auto compiledConfig = parser.loadCompiled(image);
+
+    ASSERT_EQ(compiledConfig.root().paramsCount(), 2u);
+    EXPECT_EQ(compiledConfig.root().param("a").value(), "1");
+    EXPECT_EQ(compiledConfig.tree().root().asItem().param("a").value(), "1");
+}
+
+TEST(TestCompiledConfig, File)
+{
+    const auto configPath = std::filesystem::temp_directory_path() / "test_compiledconfig.shoal";
+    const auto imagePath = std::filesystem::temp_directory_path() / "test_compiledconfig.shoalbin";
+    {
+        auto file = std::ofstream{configPath, std::ios::binary};
+        file << config;
+    }
+
+    auto parser = figcone::shoal::Parser{};
+    parser.compileFile(configPath, imagePath);
+    {
+        const auto compiledConfig = parser.loadCompiledFile(imagePath);
+        EXPECT_EQ(compiledConfig.root().node("a").node("b").param("baz").value(), "x");
+    }
+    std::filesystem::remove(configPath);
+    std::filesystem::remove(imagePath);
+}
+
+TEST(TestCompiledConfig, MissingNodeAndParam)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile(config);
+    const auto compiledConfig = parser.loadCompiled(image);
+
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                compiledConfig.root().node("a").node("unknown");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "[line:2, column:1] Config node 'a' doesn't have a node 'unknown'");
+            });
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                compiledConfig.root().node("a").param("unknown");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "[line:2, column:1] Config node 'a' doesn't have a param 'unknown'");
+            });
+}
+
+TEST(TestCompiledConfig, InvalidImage)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto image = parser.compile(config);
+
+    const auto expectInvalidImage = [&](const std::string& brokenImage, const std::string& message)
+    {
+        assert_exception<figcone::ConfigError>(
+                [&]
+                {
+                    parser.loadCompiled(brokenImage);
+                },
+                [&](const figcone::ConfigError& error)
+                {
+                    EXPECT_EQ(std::string{error.what()}, "Invalid compiled config: " + message);
+                });
+    };
+
+    expectInvalidImage(std::string{config}, "unknown format");
+    expectInvalidImage(image.substr(0, image.size() - 1), "the size of the tables doesn't match the size of the data");
+
+    auto brokenImage = image;
+    brokenImage[8] = 2;
+    expectInvalidImage(brokenImage, "unsupported version 2");
+
+    // Swaps the names of the first two child nodes of the root, breaking their order
+    brokenImage = image;
+    const auto nodeRecordSize = 36;
+    const auto firstChildOffset = 32 + nodeRecordSize;
+    std::swap_ranges(
+            brokenImage.begin() + firstChildOffset,
+            brokenImage.begin() + firstChildOffset + 8,
+            brokenImage.begin() + firstChildOffset + nodeRecordSize);
+    expectInvalidImage(brokenImage, "node #0 has unsorted child nodes");
+}
+
+} //namespace test_compiledconfig
@@ -0,0 +1,228 @@
+#ifdef __linux__
+
+#include "assert_exception.h"
+#include <figcone_shoal/configwatcher.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test_configwatcher {
+
+using namespace std::chrono_literals;
+
+class TestConfigWatcher : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        std::filesystem::create_directories(directory_);
+        writeFile("foo = 1\n");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory_);
+    }
+
+    void writeFile(const std::string& content)
+    {
+        auto file = std::ofstream{path_, std::ios::binary};
+        file << content;
+    }
+
+    void replaceFile(const std::string& content)
+    {
+        const auto tempPath = directory_ / "config.shoal.tmp";
+        {
+            auto file = std::ofstream{tempPath, std::ios::binary};
+            file << content;
+        }
+        std::filesystem::rename(tempPath, path_);
+    }
+
+    const std::filesystem::path& path() const
+    {
+        return path_;
+    }
+
+    void onTree(const std::filesystem::path&, figcone::Tree tree)
+    {
+        auto lock = std::lock_guard{mutex_};
+        values_.push_back(tree.root().asItem().param("foo").value());
+        valuePublished_.notify_all();
+    }
+
+    void onError(const std::filesystem::path&, const figcone::ConfigError& error)
+    {
+        auto lock = std::lock_guard{mutex_};
+        errors_.emplace_back(error.what());
+        errorReported_.notify_all();
+    }
+
+    bool waitForValues(std::size_t count)
+    {
+        auto lock = std::unique_lock{mutex_};
+        return valuePublished_.wait_for(
+                lock,
+                5s,
+                [&]
+                {
+                    return values_.size() >= count;
+                });
+    }
+
+    bool waitForErrors(std::size_t count)
+    {
+        auto lock = std::unique_lock{mutex_};
+        return errorReported_.wait_for(
+                lock,
+                5s,
+                [&]
+                {
+                    return errors_.size() >= count;
+                });
+    }
+
+    figcone::shoal::ConfigWatcher::TreeHandler treeHandler()
+    {
+        return [this](const std::filesystem::path& path, figcone::Tree tree)
+        {
+            onTree(path, std::move(tree));
+        };
+    }
+
+    figcone::shoal::ConfigWatcher::ErrorHandler errorHandler()
+    {
+        return [this](const std::filesystem::path& path, const figcone::ConfigError& error)
+        {
+            onError(path, error);
+        };
+    }
+
+    std::vector<std::string> values_;
+    std::vector<std::string> errors_;
+
+private:
+    std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "test_figcone_shoal_configwatcher";
+    std::filesystem::path path_ = directory_ / "config.shoal";
+    std::mutex mutex_;
+    std::condition_variable valuePublished_;
+    std::condition_variable errorReported_;
+};
+
+TEST_F(TestConfigWatcher, PublishChangedFile)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler()};
+    watcher.setDebounceDelay(10ms);
+    const auto tree = watcher.watch(path());
+    EXPECT_EQ(tree.root().asItem().param("foo").value(), "1");
+
+    writeFile("foo = 2\n");
+    EXPECT_EQ(watcher.processEvents(5s), 1u);
+    EXPECT_EQ(values_, (std::vector<std::string>{"2"}));
+
+    replaceFile("foo = 3\n");
+    EXPECT_EQ(watcher.processEvents(5s), 1u);
+    EXPECT_EQ(values_, (std::vector<std::string>{"2", "3"}));
+}
+
+TEST_F(TestConfigWatcher, SkipUnchangedContent)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler()};
+    watcher.setDebounceDelay(10ms);
+    watcher.watch(path());
+
+    writeFile("foo = 1\n");
+    EXPECT_EQ(watcher.processEvents(200ms), 0u);
+    EXPECT_TRUE(values_.empty());
+}
+
+TEST_F(TestConfigWatcher, DebounceWrites)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler()};
+    watcher.setDebounceDelay(100ms);
+    watcher.watch(path());
+
+    for (auto i = 2; i < 6; ++i)
+        writeFile("foo = " + std::to_string(i) + "\n");
+    EXPECT_EQ(watcher.processEvents(5s), 1u);
+    EXPECT_EQ(values_, (std::vector<std::string>{"5"}));
+}
+
+TEST_F(TestConfigWatcher, ReportParsingError)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler(), errorHandler()};
+    watcher.setDebounceDelay(10ms);
+    watcher.watch(path());
+
+    writeFile("foo = 2\n#a: b\n");
+    EXPECT_EQ(watcher.processEvents(300ms), 0u);
+    EXPECT_TRUE(values_.empty());
+    ASSERT_EQ(errors_.size(), 1u);
+    EXPECT_EQ(
+            errors_.at(0),
+            "[line:2, column:4] Wrong config node 'a' format: only whitespaces and comments can be placed on the same "
+            "line with config node's name.");
+}
+
+TEST_F(TestConfigWatcher, BackgroundThread)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler()};
+    watcher.setDebounceDelay(10ms);
+    watcher.watch(path());
+    watcher.start();
+
+    replaceFile("foo = 2\n");
+    EXPECT_TRUE(waitForValues(1));
+    watcher.stop();
+    EXPECT_EQ(values_, (std::vector<std::string>{"2"}));
+}
+
+TEST_F(TestConfigWatcher, BackgroundThreadReportsHandlerError)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{
+            [this](const std::filesystem::path& path, figcone::Tree tree)
+            {
+                if (tree.root().asItem().param("foo").value() == "2")
+                    throw std::runtime_error{"Can't apply the config"};
+                onTree(path, std::move(tree));
+            },
+            errorHandler()};
+    watcher.setDebounceDelay(10ms);
+    watcher.watch(path());
+    watcher.start();
+
+    replaceFile("foo = 2\n");
+    EXPECT_TRUE(waitForErrors(1));
+    replaceFile("foo = 3\n");
+    EXPECT_TRUE(waitForValues(1));
+    watcher.stop();
+    EXPECT_EQ(errors_, (std::vector<std::string>{"Can't apply the config"}));
+    EXPECT_EQ(values_, (std::vector<std::string>{"3"}));
+}
+
+TEST_F(TestConfigWatcher, WatchMissingFile)
+{
+    auto watcher = figcone::shoal::ConfigWatcher{treeHandler()};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                watcher.watch(path().parent_path() / "missing.shoal");
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "Can't open config file '" + (path().parent_path() / "missing.shoal").string() +
+                                "' for reading");
+            });
+}
+
+} //namespace test_configwatcher
+
+#endif //__linux__
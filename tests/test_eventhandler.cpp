@@ -0,0 +1,194 @@
+#include "assert_exception.h"
+#include <figcone_shoal/ieventhandler.h>
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_eventhandler {
+
+class EventRecorder : public figcone::shoal::IEventHandler {
+public:
+    void onNodeBegin(std::string_view name, const figcone::StreamPosition& position) override
+    {
+        record("node " + std::string{name}, position);
+    }
+
+    void onNodeListBegin(std::string_view name, const figcone::StreamPosition& position) override
+    {
+        record("list " + std::string{name}, position);
+    }
+
+    void onListElement(const figcone::StreamPosition& position) override
+    {
+        record("element", position);
+    }
+
+    void onParam(std::string_view name, std::string_view value, const figcone::shoal::ParamPosition& position) override
+    {
+        record("param " + std::string{name} + "=" + std::string{value}, position.resolve());
+    }
+
+    void onParamList(
+            std::string_view name,
+            const std::vector<std::string_view>& valueList,
+            const figcone::shoal::ParamPosition& position) override
+    {
+        auto event = "paramList " + std::string{name} + "=";
+        for (const auto& value : valueList)
+            event += "[" + std::string{value} + "]";
+        record(event, position.resolve());
+    }
+
+    void onNodeEnd() override
+    {
+        events.emplace_back("end");
+    }
+
+    std::vector<std::string> events;
+
+private:
+    void record(const std::string& event, const figcone::StreamPosition& position)
+    {
+        events.emplace_back(
+                event + " " + std::to_string(position.line.value_or(0)) + ":" +
+                std::to_string(position.column.value_or(0)));
+    }
+};
+
+auto parseEvents(std::string_view str)
+{
+    auto recorder = EventRecorder{};
+    auto parser = figcone::shoal::Parser{};
+    parser.parse(str, recorder);
+    return recorder.events;
+}
+
+TEST(TestEventHandler, Events)
+{
+    const auto events = parseEvents(R"(foo = 5
+#a:
+  bar = [1, 2]
+  #b:
+    baz = 'x'
+---
+#c:
+###
+  x = 1
+###
+  #d:
+  -
+  y = 2
+)");
+
+    const auto expectedEvents = std::vector<std::string>{
+            "param foo=5 1:1",
+            "node a 2:1",
+            "paramList bar=[1][2] 3:3",
+            "node b 4:3",
+            "param baz=x 5:5",
+            "end",
+            "end",
+            "list c 7:1",
+            "element 9:3",
+            "param x=1 9:3",
+            "end",
+            "element 11:3",
+            "node d 11:3",
+            "end",
+            "param y=2 13:3",
+            "end",
+            "end"};
+    EXPECT_EQ(events, expectedEvents);
+}
+
+TEST(TestEventHandler, StreamInput)
+{
+    auto input = std::stringstream{"#a:\nfoo = 1,2\n"};
+    auto recorder = EventRecorder{};
+    auto parser = figcone::shoal::Parser{};
+    parser.parse(input, recorder);
+
+    const auto expectedEvents = std::vector<std::string>{"node a 1:1", "paramList foo=[1][2] 2:1", "end"};
+    EXPECT_EQ(recorder.events, expectedEvents);
+}
+
+TEST(TestEventHandler, DuplicateNodeError)
+{
+    auto recorder = EventRecorder{};
+    auto parser = figcone::shoal::Parser{};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parse("#a:\n-\n#a:\n", recorder);
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, "[line:3, column:1] Config node 'a' already exist");
+            });
+}
+
+TEST(TestEventHandler, CloseNestedNodeWithSameName)
+{
+    const auto events = parseEvents(R"(#a:
+  #b:
+    #a:
+      x = 1
+      --a
+    y = 2
+--a
+z = 3
+)");
+
+    const auto expectedEvents = std::vector<std::string>{
+            "node a 1:1",
+            "node b 2:3",
+            "node a 3:5",
+            "param x=1 4:7",
+            "end",
+            "param y=2 6:5",
+            "end",
+            "end",
+            "param z=3 8:1"};
+    EXPECT_EQ(events, expectedEvents);
+}
+
+TEST(TestEventHandler, DeepNesting)
+{
+    const auto depth = 200000;
+    auto config = std::string{};
+    for (auto i = 0; i < depth; ++i)
+        config += "#node" + std::to_string(i) + ":\n";
+    config += "--node1\nx = 1\n---\ny = 2\n";
+
+    const auto events = parseEvents(config);
+    ASSERT_EQ(events.size(), 2u * depth + 2u);
+    EXPECT_EQ(events[depth - 1], "node node" + std::to_string(depth - 1) + " " + std::to_string(depth) + ":1");
+    EXPECT_EQ(events[depth], "end");
+    EXPECT_EQ(events[2 * depth - 2], "end");
+    EXPECT_EQ(events[2 * depth - 1], "param x=1 " + std::to_string(depth + 2) + ":1");
+    EXPECT_EQ(events[2 * depth], "end");
+    EXPECT_EQ(events[2 * depth + 1], "param y=2 " + std::to_string(depth + 4) + ":1");
+}
+
+TEST(TestEventHandler, DeepNestingListElements)
+{
+    const auto depth = 100000;
+    auto config = std::string{};
+    for (auto i = 0; i < depth; ++i)
+        config += "#list:\n###\n";
+    config += "--list\nx = 1\n";
+
+    const auto events = parseEvents(config);
+    // The last list has an empty element, '--list' closes it and continues in the element of the previous list
+    ASSERT_EQ(events.size(), 4u * depth - 1u);
+    EXPECT_EQ(events[2 * depth - 3], "element " + std::to_string(2 * depth - 1) + ":1");
+    EXPECT_EQ(events[2 * depth - 2], "list list " + std::to_string(2 * depth - 1) + ":1");
+    EXPECT_EQ(events[2 * depth - 1], "end");
+    EXPECT_EQ(events[2 * depth], "param x=1 " + std::to_string(2 * depth + 2) + ":1");
+    EXPECT_EQ(events.back(), "end");
+}
+
+} //namespace test_eventhandler
@@ -0,0 +1,214 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace test_fileparser {
+
+class TestFileParser : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        std::filesystem::remove(path_);
+        std::filesystem::remove_all(cacheDirectory_);
+    }
+
+    const std::filesystem::path& path() const
+    {
+        return path_;
+    }
+
+    const std::filesystem::path& writeFile(const std::string& content)
+    {
+        auto file = std::ofstream{path_, std::ios::binary};
+        file << content;
+        return path_;
+    }
+
+    const std::filesystem::path& cacheDirectory() const
+    {
+        return cacheDirectory_;
+    }
+
+    std::vector<std::filesystem::path> cacheEntries() const
+    {
+        auto result = std::vector<std::filesystem::path>{};
+        for (const auto& entry : std::filesystem::directory_iterator{cacheDirectory_})
+            result.push_back(entry.path());
+        return result;
+    }
+
+private:
+    std::filesystem::path path_ = std::filesystem::temp_directory_path() / "test_figcone_shoal_fileparser.shoal";
+    std::filesystem::path cacheDirectory_ =
+            std::filesystem::temp_directory_path() / "test_figcone_shoal_fileparser_cache";
+};
+
+std::string readFile(const std::filesystem::path& path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+TEST_F(TestFileParser, ParseFile)
+{
+    const auto& path = writeFile("foo = 5\r\n#a:\r\n  bar = [1, 2]\r\n  baz = 'test'\r\n");
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.parseFile(path);
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 1);
+    EXPECT_EQ(tree.param("foo").value(), "5");
+    ASSERT_EQ(tree.nodesCount(), 1);
+    auto& aNode = tree.node("a").asItem();
+    ASSERT_EQ(aNode.paramsCount(), 2);
+    EXPECT_EQ(aNode.param("bar").valueList(), (std::vector<std::string>{"1", "2"}));
+    EXPECT_EQ(aNode.param("baz").value(), "test");
+}
+
+TEST_F(TestFileParser, ParseFileLazy)
+{
+    const auto& path = writeFile("foo = 5\r\n#a:\r\n  bar = [1, 2]\r\n-\r\n#b:\r\n  baz = 'test'\r\n");
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseFileLazy(path);
+
+    ASSERT_EQ(document.root().nodesCount(), 2u);
+    auto& bNode = document.root().node("b").tree().asItem();
+    ASSERT_EQ(bNode.paramsCount(), 1);
+    EXPECT_EQ(bNode.param("baz").value(), "test");
+}
+
+TEST_F(TestFileParser, ParseEmptyFile)
+{
+    const auto& path = writeFile("");
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.parseFile(path);
+
+    auto& tree = result.root().asItem();
+    EXPECT_EQ(tree.paramsCount(), 0);
+    EXPECT_EQ(tree.nodesCount(), 0);
+}
+
+TEST_F(TestFileParser, ParseFileError)
+{
+    const auto& path = writeFile("foo = 5\n#a:\n  bar baz\n");
+    auto parser = figcone::shoal::Parser{};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parseFile(path);
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, "[line:3, column:7] Wrong param 'bar' format: missing '='");
+            });
+}
+
+TEST_F(TestFileParser, ParseFileWithCache)
+{
+    const auto& path =
+            writeFile("foo = 5\r\n#a:\r\n  bar = [1, 2]\r\n  baz = 'test'\r\n-\r\n#list:\r\n###\r\n  x = 1\r\n");
+    auto parser = figcone::shoal::Parser{};
+    parser.enableParseCache(cacheDirectory());
+    parser.parseFile(path);
+    const auto entries = cacheEntries();
+    ASSERT_EQ(entries.size(), 1u);
+
+    // Changing the stored value shows that the entry is used instead of parsing the file
+    auto entry = readFile(entries.at(0));
+    entry.replace(entry.rfind("test"), 4, "TEST");
+    {
+        auto file = std::ofstream{entries.at(0), std::ios::binary};
+        file << entry;
+    }
+
+    auto result = parser.parseFile(path);
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 1);
+    EXPECT_EQ(tree.param("foo").value(), "5");
+    ASSERT_EQ(tree.nodesCount(), 2);
+    auto& aNode = tree.node("a").asItem();
+    EXPECT_EQ(tree.node("a").position().line, 2);
+    EXPECT_EQ(tree.node("a").position().column, 1);
+    ASSERT_EQ(aNode.paramsCount(), 2);
+    EXPECT_EQ(aNode.param("bar").valueList(), (std::vector<std::string>{"1", "2"}));
+    EXPECT_EQ(aNode.param("baz").value(), "TEST");
+    ASSERT_EQ(tree.node("list").asList().size(), 1);
+    EXPECT_EQ(tree.node("list").asList().at(0).position().line, 8);
+    EXPECT_EQ(tree.node("list").asList().at(0).position().column, 3);
+    EXPECT_EQ(tree.node("list").asList().at(0).asItem().param("x").value(), "1");
+}
+
+TEST_F(TestFileParser, ParseChangedFileWithCache)
+{
+    auto parser = figcone::shoal::Parser{};
+    parser.enableParseCache(cacheDirectory());
+    parser.parseFile(writeFile("foo = 5\n"));
+    auto result = parser.parseFile(writeFile("foo = 6\n"));
+    EXPECT_EQ(result.root().asItem().param("foo").value(), "6");
+    ASSERT_EQ(cacheEntries().size(), 1u);
+
+    // Broken entry is ignored and replaced
+    {
+        auto file = std::ofstream{cacheEntries().at(0), std::ios::binary | std::ios::app};
+        file << "broken";
+    }
+    result = parser.parseFile(path());
+    EXPECT_EQ(result.root().asItem().param("foo").value(), "6");
+    EXPECT_EQ(readFile(cacheEntries().at(0)).find("broken"), std::string::npos);
+}
+
+TEST_F(TestFileParser, EntryWithWrongStructureIsIgnored)
+{
+    const auto& path = writeFile("#node_a:\n  x = 1\n-\n#node_b:\n  y = 2\n");
+    auto parser = figcone::shoal::Parser{};
+    parser.enableParseCache(cacheDirectory());
+    parser.parseFile(path);
+    ASSERT_EQ(cacheEntries().size(), 1u);
+    const auto entry = readFile(cacheEntries().at(0));
+
+    auto checkFileIsParsed = [&](const std::string& brokenEntry)
+    {
+        {
+            auto file = std::ofstream{cacheEntries().at(0), std::ios::binary};
+            file << brokenEntry;
+        }
+        auto result = parser.parseFile(path);
+        auto& tree = result.root().asItem();
+        ASSERT_EQ(tree.nodesCount(), 2);
+        EXPECT_EQ(tree.node("node_a").asItem().param("x").value(), "1");
+        EXPECT_EQ(tree.node("node_b").asItem().param("y").value(), "2");
+    };
+
+    // Nodes with the same name
+    auto duplicateNodeEntry = entry;
+    duplicateNodeEntry.replace(duplicateNodeEntry.rfind("node_b"), 6, "node_a");
+    checkFileIsParsed(duplicateNodeEntry);
+
+    // Node list with a param instead of list elements, the event type precedes the name's 4 byte size
+    auto paramInNodeListEntry = entry;
+    paramInNodeListEntry[paramInNodeListEntry.rfind("node_b") - 5] = 2;
+    checkFileIsParsed(paramInNodeListEntry);
+}
+
+TEST_F(TestFileParser, MissingFileError)
+{
+    auto parser = figcone::shoal::Parser{};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parseFile("missing_test_figcone_shoal_file.shoal");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "Can't open config file 'missing_test_figcone_shoal_file.shoal' for reading");
+            });
+}
+
+} //namespace test_fileparser
@@ -0,0 +1,149 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace test_incrementalparser {
+
+std::string describe(const figcone::TreeNode& node)
+{
+    auto result = "(" + std::to_string(node.position().line.value_or(0)) + ":" +
+            std::to_string(node.position().column.value_or(0)) + ")";
+    if (node.isList()) {
+        result += "[";
+        for (auto i = 0; i < node.asList().size(); ++i)
+            result += describe(node.asList().at(i)) + ",";
+        return result + "]";
+    }
+    result += "{";
+    const auto& item = node.asItem();
+    for (const auto& name : {"x", "y", "z"}) {
+        if (!item.hasParam(name))
+            continue;
+        const auto& param = item.param(name);
+        result += std::string{name} + "=";
+        if (param.isItem())
+            result += param.value();
+        else
+            for (const auto& value : param.valueList())
+                result += value + ";";
+        result += ",";
+    }
+    for (const auto& name : {"a", "b", "c", "list", "d", "e"})
+        if (item.hasNode(name))
+            result += std::string{name} + ":" + describe(item.node(name)) + ",";
+    return result + "}";
+}
+
+std::string describeParsed(const std::string& text)
+{
+    auto parser = figcone::shoal::Parser{};
+    return describe(parser.parse(std::string_view{text}).root());
+}
+
+const auto config = std::string{R"(x = 1
+#a:
+  y = [1,
+       2]
+  #b:
+	  z = 'x'
+  #c:
+    --a
+#list:
+###
+  x = 1
+  #d:
+    y = 2
+###
+  x = 3
+---
+#e: ;comment #c:
+  z = "multiline
+#notANode:"
+)"};
+
+TEST(TestIncrementalParser, Parse)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseIncremental(config);
+    EXPECT_EQ(document.text(), config);
+    EXPECT_EQ(document.reparsedSize(), config.size());
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(config));
+}
+
+TEST(TestIncrementalParser, EditInListElement)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto document = parser.parseIncremental(config);
+    const auto offset = config.find("y = 2");
+    document.update(offset, 5, "y = 42\n    z = 0");
+
+    auto expectedText = config;
+    expectedText.replace(offset, 5, "y = 42\n    z = 0");
+    EXPECT_EQ(document.text(), expectedText);
+    EXPECT_EQ(document.reparsedSize(), std::string{"#d:\n    y = 42\n    z = 0\n"}.size());
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(expectedText));
+}
+
+TEST(TestIncrementalParser, EditShiftsFollowingNodes)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto document = parser.parseIncremental(config);
+    auto text = config;
+    text.replace(text.find("z = 'x'"), 7, "z = 'y'\n\n  ;comment");
+    document.update(text);
+    EXPECT_LT(document.reparsedSize(), config.size() / 3);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+
+    text.replace(text.find("= 3"), 3, "= 3\n\n\n  y = [4, 5]");
+    document.update(text);
+    EXPECT_LT(document.reparsedSize(), config.size() / 3);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+
+    text.replace(text.find("#e:"), 3, "#e:\n  x = 0\n");
+    document.update(text);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+}
+
+TEST(TestIncrementalParser, EditChangingStructure)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto document = parser.parseIncremental(config);
+    auto text = config;
+    text.replace(text.find("--a"), 3, "-");
+    document.update(text);
+    EXPECT_EQ(document.reparsedSize(), text.size());
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+
+    text.replace(text.find("  x = 3"), 7, "  x = 3\n-");
+    document.update(text);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+
+    text.replace(text.find("#d:"), 3, "#d:\n###");
+    document.update(text);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(text));
+}
+
+TEST(TestIncrementalParser, EditingError)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto document = parser.parseIncremental(config);
+    auto text = config;
+    text.replace(text.find("y = 2"), 5, "y = 2\n    z");
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                document.update(text);
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "[line:14, column:6] Wrong param 'z' format: parameter's value must be placed on the same "
+                        "line as its name");
+            });
+    EXPECT_EQ(document.text(), config);
+    EXPECT_EQ(describe(document.tree().root()), describeParsed(config));
+}
+
+} //namespace test_incrementalparser
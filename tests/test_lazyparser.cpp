@@ -0,0 +1,193 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_lazyparser {
+
+void expectPosition(const figcone::StreamPosition& position, int line, int column)
+{
+    EXPECT_EQ(position.line, line);
+    EXPECT_EQ(position.column, column);
+}
+
+std::string describe(const figcone::TreeNode& node)
+{
+    if (node.isList()) {
+        auto result = std::string{"["};
+        for (auto i = 0; i < node.asList().size(); ++i)
+            result += describe(node.asList().at(i)) + ",";
+        return result + "]";
+    }
+    auto result = std::string{"{"};
+    const auto& item = node.asItem();
+    for (const auto& name : {"x", "y"})
+        if (item.hasParam(name))
+            result += std::string{name} + "=" + item.param(name).value() + ",";
+    for (const auto& name : {"a", "b", "c", "d"})
+        if (item.hasNode(name))
+            result += std::string{name} + ":" + describe(item.node(name)) + ",";
+    return result + "}";
+}
+
+constexpr auto config = std::string_view{R"(foo = 5
+#a:
+  bar = [1,
+         2]
+  #b:
+	  baz = 'x'
+  #c:
+    --a
+#list:
+###
+  x = 1
+  #d:
+    y = 2
+###
+  x = 3
+---
+#e:
+  z = "multiline
+#notANode:"
+)"};
+
+TEST(TestLazyParser, NodeIndex)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseLazy(config);
+
+    const auto& root = document.root();
+    EXPECT_EQ(root.nodesCount(), 3u);
+    ASSERT_TRUE(root.hasNode("a"));
+    ASSERT_TRUE(root.hasNode("list"));
+    ASSERT_TRUE(root.hasNode("e"));
+    EXPECT_FALSE(root.hasNode("notANode"));
+
+    const auto& aNode = root.node("a");
+    EXPECT_FALSE(aNode.isList());
+    expectPosition(aNode.position(), 2, 1);
+    EXPECT_EQ(aNode.nodesCount(), 1u);
+    EXPECT_EQ(aNode.node("b").nodesCount(), 1u);
+
+    const auto& listNode = root.node("list");
+    EXPECT_TRUE(listNode.isList());
+    ASSERT_EQ(listNode.size(), 2u);
+    EXPECT_EQ(listNode.at(0).name(), "list");
+    expectPosition(listNode.at(0).position(), 11, 3);
+    EXPECT_TRUE(listNode.at(0).hasNode("d"));
+    EXPECT_EQ(listNode.at(1).nodesCount(), 0u);
+}
+
+TEST(TestLazyParser, NodeContent)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseLazy(config);
+    const auto& root = document.root();
+
+    const auto& bNode = root.node("a").node("b").tree().asItem();
+    ASSERT_EQ(bNode.paramsCount(), 1);
+    EXPECT_EQ(bNode.param("baz").value(), "x");
+    ASSERT_EQ(bNode.nodesCount(), 1);
+    expectPosition(bNode.node("c").position(), 7, 3);
+
+    const auto& aNode = root.node("a").tree().asItem();
+    ASSERT_EQ(aNode.paramsCount(), 1);
+    EXPECT_EQ(aNode.param("bar").valueList(), (std::vector<std::string>{"1", "2"}));
+    ASSERT_EQ(aNode.nodesCount(), 1);
+    EXPECT_EQ(aNode.node("b").asItem().param("baz").value(), "x");
+    expectPosition(aNode.node("b").position(), 5, 3);
+
+    const auto& firstElement = root.node("list").at(0).tree().asItem();
+    ASSERT_EQ(firstElement.paramsCount(), 1);
+    EXPECT_EQ(firstElement.param("x").value(), "1");
+    ASSERT_EQ(firstElement.nodesCount(), 1);
+    expectPosition(firstElement.node("d").position(), 12, 3);
+    EXPECT_EQ(firstElement.node("d").asItem().param("y").value(), "2");
+
+    const auto& secondElement = root.node("list").at(1).tree().asItem();
+    ASSERT_EQ(secondElement.paramsCount(), 1);
+    EXPECT_EQ(secondElement.param("x").value(), "3");
+
+    const auto& eNode = root.node("e").tree().asItem();
+    ASSERT_EQ(eNode.paramsCount(), 1);
+    EXPECT_EQ(eNode.param("z").value(), "multiline\n#notANode:");
+}
+
+TEST(TestLazyParser, RootContent)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseLazy(config);
+
+    const auto& root = document.root().tree().asItem();
+    ASSERT_EQ(root.paramsCount(), 1);
+    EXPECT_EQ(root.param("foo").value(), "5");
+    ASSERT_EQ(root.nodesCount(), 3);
+    ASSERT_EQ(root.node("list").asList().size(), 2);
+}
+
+TEST(TestLazyParser, MissingNode)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto document = parser.parseLazy("#a:\n  x = 1\n");
+
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                document.root().node("a").node("b");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, "[line:1, column:1] Config node 'a' doesn't have a node 'b'");
+            });
+}
+
+TEST(TestLazyParser, ErrorsAreReportedOnIndexing)
+{
+    auto parser = figcone::shoal::Parser{};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parseLazy("#a:\n  #b:\n    x = 1\n    x y\n");
+            },
+            [](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(
+                        std::string{error.what()},
+                        "[line:4, column:7] Wrong param 'x' format: missing '='");
+            });
+}
+
+TEST(TestLazyParser, NodeHeaderOnLastLine)
+{
+    auto parser = figcone::shoal::Parser{};
+    for (const auto data : {"x=1\n#a:", "x=1\n#a: ;c", "x=1\r\n#a:", "x=1\n#b:\n  #a:"}) {
+        const auto document = parser.parseLazy(data);
+        const auto& root = document.root();
+        const auto& aNode = root.hasNode("b") ? root.node("b").node("a") : root.node("a");
+        const auto& tree = aNode.tree().asItem();
+        EXPECT_EQ(tree.nodesCount(), 0) << data;
+        EXPECT_EQ(tree.paramsCount(), 0) << data;
+    }
+}
+
+TEST(TestLazyParser, EmptyListElementClosingParentNodes)
+{
+    auto parser = figcone::shoal::Parser{};
+    for (const auto data :
+         {"#a:\n  #c:\n  ###\n---\n#b:\n  x = 1\n",
+          "#a:\n  #b:\n    #c:\n    ###\n  --a\n  x = 1\n",
+          "#a:\n  #c:\n  ###\n  -\n  x = 2\n#b:\n  y = 3\n",
+          "#a:\n  #b:\n    #c:\n    ###\n    ###\n      x = 1\n    ###\n---\n#d:\n  y = 2\n",
+          "#a:\n  #c:\n  ###"}) {
+        const auto document = parser.parseLazy(data);
+        const auto tree = parser.parse(std::string_view{data});
+        for (const auto& name : {"a", "b", "d"})
+            if (tree.root().asItem().hasNode(name))
+                EXPECT_EQ(describe(document.root().node(name).tree()), describe(tree.root().asItem().node(name)))
+                        << data;
+    }
+}
+
+} //namespace test_lazyparser
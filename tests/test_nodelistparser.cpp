@@ -618,4 +618,39 @@ TEST(TestNodeListParser, InvalidListError)
             });
 }
 
+TEST(TestNodeListParser, StringInterning)
+{
+    auto config = std::string{"#testNodes:\n"};
+    for (auto i = 0; i < 100; ++i)
+        config += "###\n  testInt = 3\n  testStr = 'Hello world'\n  testList = [foo, bar, " + std::to_string(i) +
+                "]\n  #testNode:\n    testDouble = 0.5\n";
+    auto parser = figcone::shoal::Parser{};
+    parser.enableStringInterning();
+    auto input = std::stringstream{config};
+    auto result = parser.parse(input);
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.nodesCount(), 1);
+    auto& testNodes = tree.node("testNodes").asList();
+    ASSERT_EQ(testNodes.size(), 100);
+    for (auto i = 0; i < 100; ++i) {
+        auto& node = testNodes.at(i).asItem();
+        EXPECT_EQ(node.param("testInt").value(), "3");
+        EXPECT_EQ(node.param("testStr").value(), "Hello world");
+        EXPECT_EQ(
+                node.param("testList").valueList(),
+                (std::vector<std::string>{"foo", "bar", std::to_string(i)}));
+        EXPECT_EQ(node.node("testNode").asItem().param("testDouble").value(), "0.5");
+    }
+
+    const auto& report = parser.stringInterningReport();
+    EXPECT_GE(report.reusedStringsCount, 99u * 10);
+    EXPECT_GT(report.savedBytes, 99u * 60);
+
+    parser.enableStringInterning(false);
+    auto input2 = std::stringstream{config};
+    parser.parse(input2);
+    EXPECT_EQ(parser.stringInterningReport().reusedStringsCount, 0u);
+}
+
 } //namespace test_nodelistparser
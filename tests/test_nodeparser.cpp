@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <sstream>
+#include <string>
 
 namespace test_nodeparser {
 
@@ -388,6 +389,19 @@ TEST(TestNodeParser, ReturnToParentClosingTokenError)
             });
 }
 
+TEST(TestNodeParser, NodeNameLongerThanArenaBlock)
+{
+    // The name fills an arena block of its size, so the following allocations must be placed in a new one
+    const auto name = std::string(100001, 'x');
+    const auto config = "#" + name + ":\n  foo = 1\n";
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.parse(std::string_view{config});
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.nodesCount(), 1);
+    EXPECT_EQ(tree.node(name).asItem().param("foo").value(), "1");
+}
+
 TEST(TestNodeParser, InvalidNodeNameLineError)
 {
     assert_exception<figcone::ConfigError>(
@@ -0,0 +1,199 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <string_view>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+namespace test_parallelparser {
+
+std::string describe(const figcone::TreeNode& node)
+{
+    if (node.isList()) {
+        auto result = std::string{"["};
+        for (auto i = 0; i < node.asList().size(); ++i)
+            result += describe(node.asList().at(i)) + ",";
+        return result + "]";
+    }
+    auto result = std::string{"{"};
+    const auto& item = node.asItem();
+    for (const auto& name : {"name", "path", "list", "text"}) {
+        if (!item.hasParam(name))
+            continue;
+        const auto& param = item.param(name);
+        result += std::string{name} + "=";
+        if (param.isItem())
+            result += param.value();
+        else
+            for (const auto& value : param.valueList())
+                result += value + ";";
+        result += ",";
+    }
+    for (const auto& name : {"child", "items"})
+        if (item.hasNode(name))
+            result += std::string{name} + ":" + describe(item.node(name)) + ",";
+    for (auto i = 0; item.hasNode("node" + std::to_string(i)); ++i)
+        result += "node" + std::to_string(i) + ":" + describe(item.node("node" + std::to_string(i))) + ",";
+    return result + "}";
+}
+
+// Config large enough to be split into chunks, with multiline strings and lists
+// which are likely to cross the chunk boundaries
+std::string makeConfig(int nodesCount)
+{
+    auto config = std::string{};
+    for (auto i = 0; i < nodesCount; ++i) {
+        const auto index = std::to_string(i);
+        config += "#node" + index + ":\n  name = node" + index + "\n  path = '/usr/share/" + index + "' ;comment\n";
+        if (i % 7 == 0)
+            config += "  text = \"\n#notANode:\n  name = notAParam\n\"\n";
+        if (i % 11 == 0)
+            config += "  list = [\n" + index + ",\n  ;not a comment\n #notANode\n]\n";
+        config += "  #child:\n    name = " + index + "\n    #items:\n    ###\n      name = " + index +
+                "\n    ###\n      list = a, b, " + index + "\n";
+        config += i % 2 ? "    --node" + index + "\n" : "---\n";
+    }
+    return config;
+}
+
+TEST(TestParallelParser, SameTreeAsSequentialParsing)
+{
+    const auto config = makeConfig(10000);
+    ASSERT_GT(config.size(), 4u * 256 * 1024);
+
+    auto parser = figcone::shoal::Parser{};
+    const auto expectedTree = parser.parse(std::string_view{config});
+    ASSERT_TRUE(expectedTree.root().asItem().hasNode("node9999"));
+    parser.enableParallelParsing(4);
+    const auto tree = parser.parse(std::string_view{config});
+    EXPECT_EQ(describe(tree.root()), describe(expectedTree.root()));
+}
+
+TEST(TestParallelParser, ErrorInChunk)
+{
+    auto config = makeConfig(10000);
+    ASSERT_GT(config.size(), 2u * 256 * 1024);
+    config.insert(config.size() / 3 * 2, "\nerror\n");
+
+    auto parser = figcone::shoal::Parser{};
+    auto expectedError = std::string{};
+    try {
+        parser.parse(std::string_view{config});
+    }
+    catch (const figcone::ConfigError& error) {
+        expectedError = error.what();
+    }
+    ASSERT_FALSE(expectedError.empty());
+
+    parser.enableParallelParsing(4);
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parse(std::string_view{config});
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, expectedError);
+            });
+}
+
+// Config with a large node list, which elements contain nested nodes and lists
+std::string makeNodeListConfig(int elementsCount)
+{
+    auto config = std::string{"#items:\n"};
+    for (auto i = 0; i < elementsCount; ++i) {
+        const auto index = std::to_string(i);
+        config += "###\n  name = element" + index + "\n  path = '/usr/share/" + index + "' ;comment\n";
+        if (i % 5 == 0)
+            config += "  text = \"\n###\n  name = notAnElement\n\"\n";
+        if (i % 3 == 0)
+            config += "  #child:\n    name = " + index + "\n    #items:\n    ###\n      name = " + index +
+                    "\n    ###\n      list = a, b, " + index + "\n  --items\n";
+        if (i % 13 == 0)
+            config += "###\n";
+    }
+    return config + "---\n#node0:\nname = last\n";
+}
+
+TEST(TestParallelParser, NodeListSameTreeAsSequentialParsing)
+{
+    const auto config = makeNodeListConfig(20000);
+    ASSERT_GT(config.size(), 2u * 256 * 1024);
+
+    auto parser = figcone::shoal::Parser{};
+    const auto expectedTree = parser.parse(std::string_view{config});
+    ASSERT_EQ(expectedTree.root().asItem().node("items").asList().size(), 20000 + 20000 / 13 + 1);
+    parser.enableParallelParsing(4);
+    const auto tree = parser.parse(std::string_view{config});
+    EXPECT_EQ(describe(tree.root()), describe(expectedTree.root()));
+}
+
+TEST(TestParallelParser, ErrorInNodeListElements)
+{
+    auto config = makeNodeListConfig(20000);
+    ASSERT_GT(config.size(), 2u * 256 * 1024);
+    config.insert(config.find("###\n  name = element15000\n"), "###\n  name = [1\n");
+    config.insert(config.find("###\n  name = element5000\n"), "###\n  name 1\n");
+
+    auto parser = figcone::shoal::Parser{};
+    auto expectedError = std::string{};
+    try {
+        parser.parse(std::string_view{config});
+    }
+    catch (const figcone::ConfigError& error) {
+        expectedError = error.what();
+    }
+    ASSERT_FALSE(expectedError.empty());
+
+    parser.enableParallelParsing(4);
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parser.parse(std::string_view{config});
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, expectedError);
+            });
+}
+
+#ifdef __linux__
+long peakMemoryUsageKb()
+{
+    auto usage = rusage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+#endif
+
+TEST(TestParallelParser, InvalidNodeListElements)
+{
+    // Every element is invalid, so their speculative reading fails
+    auto config = std::string{"#items:\n"};
+    while (config.size() < 1024 * 1024)
+        config += "###\n  name 1\n";
+
+    auto parser = figcone::shoal::Parser{};
+    const auto expectedResult = parser.tryParse(std::string_view{config});
+    ASSERT_FALSE(expectedResult);
+
+    parser.enableParallelParsing(4);
+#ifdef __linux__
+    const auto peakMemoryUsageBeforeKb = peakMemoryUsageKb();
+#endif
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto result = parser.tryParse(std::string_view{config});
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds{5});
+#ifdef __linux__
+    EXPECT_LT(peakMemoryUsageKb() - peakMemoryUsageBeforeKb, 256 * 1024);
+#endif
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().message, expectedResult.error().message);
+    EXPECT_EQ(result.error().position.line, expectedResult.error().position.line);
+    EXPECT_EQ(result.error().position.column, expectedResult.error().position.column);
+}
+
+} //namespace test_parallelparser
@@ -0,0 +1,108 @@
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test_recoveringparser {
+
+std::vector<std::string> errorTexts(const figcone::shoal::RecoveredParseResult& result)
+{
+    auto texts = std::vector<std::string>{};
+    for (const auto& error : result.errors)
+        texts.emplace_back(figcone::ConfigError{error.message, error.position}.what());
+    return texts;
+}
+
+TEST(TestRecoveringParser, ValidDocument)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto result = parser.parseWithRecovery("foo = 1\n#a:\n  bar = 2\n");
+    EXPECT_TRUE(result.errors.empty());
+    ASSERT_TRUE(result.tree);
+    auto& tree = result.tree->root().asItem();
+    EXPECT_EQ(tree.param("foo").value(), "1");
+    EXPECT_EQ(tree.node("a").asItem().param("bar").value(), "2");
+}
+
+TEST(TestRecoveringParser, AllErrors)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto result = parser.parseWithRecovery(R"(foo = 1
+bar
+#a:
+  baz = [1, , 3]
+  x = 2
+  #b: c
+  y = 3
+  --c
+z = 4
+#list:
+### x
+  w = 5
+###
+  w = 6 7, 
+-
+v = 'unclosed
+)");
+
+    const auto expectedErrors = std::vector<std::string>{
+            "[line:2, column:4] Wrong param 'bar' format: parameter's value must be placed on the same line as its "
+            "name",
+            "[line:4, column:13] Parameter list 'baz' element is missing",
+            "[line:6, column:6] Wrong config node 'b' format: only whitespaces and comments can be placed on the same "
+            "line with config node's name.",
+            "[line:8, column:4] Can't close unexisting node 'c'",
+            "[line:11, column:5] Wrong config node list 'list' format: there can't be anything besides comments and "
+            "whitespaces on the same line with list separator '###'",
+            "[line:14, column:12] Parameter list 'w' element is missing",
+            "[line:16, column:5] String isn't closed"};
+    EXPECT_EQ(errorTexts(result), expectedErrors);
+
+    ASSERT_TRUE(result.tree);
+    auto& tree = result.tree->root().asItem();
+    EXPECT_EQ(tree.param("foo").value(), "1");
+    EXPECT_FALSE(tree.hasParam("bar"));
+    ASSERT_TRUE(tree.hasNode("a"));
+    auto& aNode = tree.node("a").asItem();
+    EXPECT_FALSE(aNode.hasParam("baz"));
+    EXPECT_EQ(aNode.param("x").value(), "2");
+    EXPECT_EQ(aNode.param("y").value(), "3");
+    EXPECT_FALSE(aNode.hasNode("b"));
+    // '--c' closes the node 'a', as '-' would
+    EXPECT_EQ(tree.param("z").value(), "4");
+    auto& list = tree.node("list").asList();
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list.at(0).asItem().param("w").value(), "5");
+    EXPECT_FALSE(list.at(1).asItem().hasParam("w"));
+    EXPECT_FALSE(tree.hasParam("v"));
+}
+
+TEST(TestRecoveringParser, WithoutTree)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto input = std::stringstream{"foo\n#a:\nbar =\n"};
+    const auto result = parser.parseWithRecovery(input, false);
+    EXPECT_FALSE(result.tree);
+    const auto expectedErrors = std::vector<std::string>{
+            "[line:1, column:4] Wrong param 'foo' format: parameter's value must be placed on the same line as its "
+            "name",
+            "[line:3, column:6] Wrong param 'bar' format: parameter's value must be placed on the same line as its "
+            "name"};
+    EXPECT_EQ(errorTexts(result), expectedErrors);
+}
+
+TEST(TestRecoveringParser, FirstErrorIsSameAsParse)
+{
+    const auto config = std::string{"#a:\n  foo = 1\n  #a:\n  -\n  #a:\n--b\n"};
+    auto parser = figcone::shoal::Parser{};
+    const auto result = parser.parseWithRecovery(config);
+    ASSERT_FALSE(result.errors.empty());
+    const auto tryParseResult = parser.tryParse(config);
+    ASSERT_FALSE(tryParseResult);
+    EXPECT_EQ(result.errors.front().message, tryParseResult.error().message);
+    EXPECT_EQ(result.errors.front().position.line, tryParseResult.error().position.line);
+    EXPECT_EQ(result.errors.front().position.column, tryParseResult.error().position.column);
+}
+
+} //namespace test_recoveringparser
@@ -0,0 +1,257 @@
+#include "assert_exception.h"
+#include <figcone_shoal/parser.h>
+#include <figcone_shoal/shoalreader.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace test_shoalreader {
+
+std::string eventName(figcone::shoal::ReaderEvent event)
+{
+    using figcone::shoal::ReaderEvent;
+    switch (event) {
+    case ReaderEvent::NodeBegin:
+        return "node";
+    case ReaderEvent::NodeListBegin:
+        return "list";
+    case ReaderEvent::ListElement:
+        return "element";
+    case ReaderEvent::Param:
+        return "param";
+    case ReaderEvent::ParamList:
+        return "paramList";
+    case ReaderEvent::NodeEnd:
+        return "end";
+    case ReaderEvent::DocumentEnd:
+        return "documentEnd";
+    default:
+        return "none";
+    }
+}
+
+std::string describe(const figcone::shoal::ShoalReader& reader)
+{
+    using figcone::shoal::ReaderEvent;
+    auto result = eventName(reader.event());
+    switch (reader.event()) {
+    case ReaderEvent::NodeBegin:
+    case ReaderEvent::NodeListBegin:
+    case ReaderEvent::ListElement:
+        result += " " + std::string{reader.name()};
+        break;
+    case ReaderEvent::Param:
+        result += " " + std::string{reader.name()} + "=" + std::string{reader.value()};
+        break;
+    case ReaderEvent::ParamList:
+        result += " " + std::string{reader.name()} + "=";
+        for (const auto& value : reader.valueList())
+            result += "[" + std::string{value} + "]";
+        break;
+    default:
+        return result;
+    }
+    const auto position = reader.position();
+    return result + " " + std::to_string(position.line.value_or(0)) + ":" +
+            std::to_string(position.column.value_or(0));
+}
+
+std::vector<std::string> readAll(figcone::shoal::ShoalReader& reader)
+{
+    auto events = std::vector<std::string>{};
+    while (reader.next() != figcone::shoal::ReaderEvent::DocumentEnd)
+        events.push_back(describe(reader));
+    return events;
+}
+
+TEST(TestShoalReader, Events)
+{
+    auto reader = figcone::shoal::ShoalReader{R"(foo = 5
+#a:
+  bar = [1, 2]
+  #b:
+    baz = 'x'
+---
+#c:
+###
+  x = 1
+###
+  #d:
+  -
+  y = 2
+)"};
+
+    const auto expectedEvents = std::vector<std::string>{
+            "param foo=5 1:1",
+            "node a 2:1",
+            "paramList bar=[1][2] 3:3",
+            "node b 4:3",
+            "param baz=x 5:5",
+            "end",
+            "end",
+            "list c 7:1",
+            "element c 9:3",
+            "param x=1 9:3",
+            "end",
+            "element c 11:3",
+            "node d 11:3",
+            "end",
+            "param y=2 13:3",
+            "end",
+            "end"};
+    EXPECT_EQ(readAll(reader), expectedEvents);
+    EXPECT_EQ(reader.next(), figcone::shoal::ReaderEvent::DocumentEnd);
+}
+
+TEST(TestShoalReader, ClosingTokens)
+{
+    auto input = std::stringstream{R"(
+#a:
+  #b:
+    #c:
+    --a
+#d:
+  #e:
+  -
+  x = 1
+###
+y = 2
+)"};
+    auto reader = figcone::shoal::ShoalReader{input};
+
+    const auto expectedEvents = std::vector<std::string>{
+            "node a 2:1",
+            "node b 3:3",
+            "node c 4:5",
+            "end",
+            "end",
+            "end",
+            "node d 6:1",
+            "node e 7:3",
+            "end",
+            "param x=1 9:3",
+            "end"};
+    EXPECT_EQ(readAll(reader), expectedEvents);
+}
+
+TEST(TestShoalReader, SkipNode)
+{
+    auto reader = figcone::shoal::ShoalReader{R"(
+#a:
+  #b:
+    x = 1
+  -
+  y = 2
+-
+#c:
+###
+  z = 3
+###
+  w = 4
+)"};
+
+    ASSERT_EQ(reader.next(), figcone::shoal::ReaderEvent::NodeBegin);
+    EXPECT_EQ(reader.depth(), 1u);
+    reader.skipNode();
+    EXPECT_EQ(reader.event(), figcone::shoal::ReaderEvent::NodeEnd);
+    EXPECT_EQ(reader.depth(), 0u);
+
+    ASSERT_EQ(reader.next(), figcone::shoal::ReaderEvent::NodeListBegin);
+    ASSERT_EQ(reader.next(), figcone::shoal::ReaderEvent::ListElement);
+    EXPECT_EQ(reader.depth(), 2u);
+    reader.skipNode();
+
+    const auto expectedEvents = std::vector<std::string>{"element c 12:3", "param w=4 12:3", "end", "end"};
+    EXPECT_EQ(readAll(reader), expectedEvents);
+}
+
+TEST(TestShoalReader, SameEventsAsParser)
+{
+    class EventRecorder : public figcone::shoal::IEventHandler {
+    public:
+        void onNodeBegin(std::string_view, const figcone::StreamPosition&) override
+        {
+            events.emplace_back("node");
+        }
+        void onNodeListBegin(std::string_view, const figcone::StreamPosition&) override
+        {
+            events.emplace_back("list");
+        }
+        void onListElement(const figcone::StreamPosition&) override
+        {
+            events.emplace_back("element");
+        }
+        void onParam(std::string_view, std::string_view, const figcone::shoal::ParamPosition&) override
+        {
+            events.emplace_back("param");
+        }
+        void onParamList(
+                std::string_view,
+                const std::vector<std::string_view>&,
+                const figcone::shoal::ParamPosition&) override
+        {
+            events.emplace_back("paramList");
+        }
+        void onNodeEnd() override
+        {
+            events.emplace_back("end");
+        }
+        std::vector<std::string> events;
+    };
+
+    const auto config = std::string_view{R"(
+#a:
+###
+  #b:
+  ###
+    x = 1
+  ###
+    y = 1, 2
+  --a
+###
+  -
+###
+---
+#c:
+z = 1
+)"};
+
+    auto recorder = EventRecorder{};
+    auto parser = figcone::shoal::Parser{};
+    parser.parse(config, recorder);
+
+    auto reader = figcone::shoal::ShoalReader{config};
+    auto events = std::vector<std::string>{};
+    while (reader.next() != figcone::shoal::ReaderEvent::DocumentEnd)
+        events.push_back(eventName(reader.event()));
+    EXPECT_EQ(events, recorder.events);
+}
+
+TEST(TestShoalReader, ErrorParity)
+{
+    const auto config = std::string_view{"#a:\n  x = 1\n-\n#a:\n"};
+    auto parserError = std::string{};
+    try {
+        auto parser = figcone::shoal::Parser{};
+        parser.parse(config);
+    }
+    catch (const figcone::ConfigError& error) {
+        parserError = error.what();
+    }
+
+    auto reader = figcone::shoal::ShoalReader{config};
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                readAll(reader);
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, parserError);
+                EXPECT_EQ(std::string{error.what()}, "[line:4, column:1] Config node 'a' already exist");
+            });
+}
+
+} //namespace test_shoalreader
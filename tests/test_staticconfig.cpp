@@ -0,0 +1,153 @@
+#include <figcone_shoal/parser.h>
+#include <figcone_shoal/staticconfig.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef FIGCONE_SHOAL_HAS_STATIC_CONFIG
+
+namespace test_staticconfig {
+
+void expectPosition(const figcone::StreamPosition& position, int line, int column)
+{
+    EXPECT_EQ(position.line, line);
+    EXPECT_EQ(position.column, column);
+}
+
+constexpr auto config = figcone::shoal::parseStatic<R"(foo = 5 ;comment
+#a:
+  bar = [1,
+         2]
+  #b:
+	baz = 'x ; y'
+--a
+#list:
+###
+  x = 1
+  #d:
+    y = "multi
+line"
+###
+  x = 3
+---
+#c:
+  foo = 5, 6
+  foo = 7
+)">();
+
+static_assert(config.root().param("foo").value() == "5");
+static_assert(config.root().node("a").node("b").param("baz").value() == "x ; y");
+static_assert(config.root().node("list").size() == 2);
+static_assert(config.root().node("list").at(0).node("d").param("y").value() == "multi\nline");
+static_assert(!config.root().hasNode("b"));
+
+TEST(TestStaticConfig, Nodes)
+{
+    const auto root = config.root();
+    EXPECT_FALSE(root.isList());
+    EXPECT_EQ(root.nodesCount(), 3u);
+    EXPECT_TRUE(root.hasNode("a"));
+    EXPECT_TRUE(root.hasNode("list"));
+    EXPECT_TRUE(root.hasNode("c"));
+
+    const auto aNode = root.node("a");
+    expectPosition(aNode.position(), 2, 1);
+    ASSERT_EQ(aNode.nodesCount(), 1u);
+    expectPosition(aNode.node("b").position(), 5, 3);
+
+    const auto listNode = root.node("list");
+    EXPECT_TRUE(listNode.isList());
+    ASSERT_EQ(listNode.size(), 2u);
+    EXPECT_EQ(listNode.at(0).name(), "list");
+    expectPosition(listNode.at(0).position(), 10, 3);
+    EXPECT_TRUE(listNode.at(0).hasNode("d"));
+    EXPECT_EQ(listNode.at(1).nodesCount(), 0u);
+}
+
+TEST(TestStaticConfig, Params)
+{
+    const auto root = config.root();
+    ASSERT_EQ(root.paramsCount(), 1u);
+    expectPosition(root.param("foo").position(), 1, 1);
+
+    const auto barParam = root.node("a").param("bar");
+    EXPECT_TRUE(barParam.isList());
+    EXPECT_EQ(barParam.valueList(), (std::vector<std::string_view>{"1", "2"}));
+    expectPosition(barParam.position(), 3, 3);
+    expectPosition(root.node("a").node("b").param("baz").position(), 6, 5);
+
+    const auto fooParam = root.node("c").param("foo");
+    EXPECT_TRUE(fooParam.isList());
+    EXPECT_EQ(fooParam.valueList(), (std::vector<std::string_view>{"5", "6"}));
+}
+
+TEST(TestStaticConfig, SameTreeAsParser)
+{
+    constexpr auto text = std::string_view{R"(foo = 5 ;comment
+#a:
+  bar = [1,
+         2]
+  #b:
+	baz = 'x ; y'
+--a
+#list:
+###
+  x = 1
+  #d:
+    y = "multi
+line"
+###
+  x = 3
+---
+#c:
+  foo = 5, 6
+  foo = 7
+)"};
+    auto parser = figcone::shoal::Parser{};
+    const auto expectedTree = parser.parse(text);
+    const auto tree = config.tree();
+
+    const auto& expectedRoot = expectedTree.root().asItem();
+    const auto& root = tree.root().asItem();
+    ASSERT_EQ(root.paramsCount(), expectedRoot.paramsCount());
+    ASSERT_EQ(root.nodesCount(), expectedRoot.nodesCount());
+    EXPECT_EQ(root.param("foo").value(), expectedRoot.param("foo").value());
+
+    const auto& aNode = root.node("a");
+    expectPosition(aNode.position(), 2, 1);
+    EXPECT_EQ(aNode.asItem().param("bar").valueList(), expectedRoot.node("a").asItem().param("bar").valueList());
+    EXPECT_EQ(
+            aNode.asItem().node("b").asItem().param("baz").value(),
+            expectedRoot.node("a").asItem().node("b").asItem().param("baz").value());
+
+    const auto& listNode = root.node("list").asList();
+    const auto& expectedListNode = expectedRoot.node("list").asList();
+    ASSERT_EQ(listNode.size(), expectedListNode.size());
+    expectPosition(listNode.at(0).position(), 10, 3);
+    EXPECT_EQ(
+            listNode.at(0).asItem().node("d").asItem().param("y").value(),
+            expectedListNode.at(0).asItem().node("d").asItem().param("y").value());
+    EXPECT_EQ(listNode.at(1).asItem().param("x").value(), expectedListNode.at(1).asItem().param("x").value());
+    EXPECT_EQ(
+            root.node("c").asItem().param("foo").valueList(),
+            expectedRoot.node("c").asItem().param("foo").valueList());
+}
+
+TEST(TestStaticConfig, MissingNode)
+{
+    EXPECT_THROW(config.root().node("unknown"), figcone::ConfigError);
+    EXPECT_THROW(config.root().param("unknown"), figcone::ConfigError);
+}
+
+TEST(TestStaticConfig, EmptyConfig)
+{
+    constexpr auto emptyConfig = figcone::shoal::parseStatic<"">();
+    EXPECT_EQ(emptyConfig.root().paramsCount(), 0u);
+    EXPECT_EQ(emptyConfig.root().nodesCount(), 0u);
+    EXPECT_EQ(emptyConfig.tree().root().asItem().nodesCount(), 0);
+}
+
+} //namespace test_staticconfig
+
+#endif
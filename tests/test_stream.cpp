@@ -0,0 +1,180 @@
+#include <lineindex.h>
+#include <stream.h>
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace test_stream {
+
+// Streambuf without seeking support, similar to a pipe or stdin.
+class ForwardOnlyBuf : public std::streambuf {
+public:
+    explicit ForwardOnlyBuf(std::string data)
+        : data_{std::move(data)}
+    {
+    }
+
+protected:
+    int_type underflow() override
+    {
+        if (pos_ == data_.size())
+            return traits_type::eof();
+        ch_ = data_[pos_++];
+        setg(&ch_, &ch_, &ch_ + 1);
+        return traits_type::to_int_type(ch_);
+    }
+
+private:
+    std::string data_;
+    std::size_t pos_ = 0;
+    char ch_ = {};
+};
+
+TEST(TestStream, ReadAndPeek)
+{
+    auto input = std::stringstream{"ab\r\ncd"};
+    auto stream = figcone::shoal::detail::Stream{input};
+    EXPECT_TRUE(stream.peekMatches("ab\n"));
+    EXPECT_EQ(stream.readChar(), 'a');
+    EXPECT_EQ(stream.readChar(), 'b');
+    EXPECT_EQ(stream.peekChar(), '\n');
+    EXPECT_EQ(stream.readChar(), '\n');
+    EXPECT_EQ(stream.position().line, 2);
+    EXPECT_EQ(stream.position().column, 1);
+    EXPECT_FALSE(stream.peekMatches("cde"));
+    EXPECT_TRUE(stream.peekMatches("cd"));
+    stream.skip(2);
+    EXPECT_TRUE(stream.atEnd());
+    EXPECT_EQ(stream.peekChar(), '\0');
+    EXPECT_EQ(stream.readChar(), '\0');
+}
+
+TEST(TestStream, PeekSkipsComments)
+{
+    auto input = std::stringstream{"a;comment\rb"};
+    auto stream = figcone::shoal::detail::Stream{input};
+    EXPECT_TRUE(stream.peekMatches("a\nb"));
+    stream.skipComments(false);
+    EXPECT_TRUE(stream.peekMatches("a;c"));
+    stream.skipComments(true);
+    stream.skip(1);
+    EXPECT_EQ(stream.peekChar(), '\n');
+    EXPECT_EQ(stream.readChar(), '\n');
+    EXPECT_EQ(stream.readChar(), 'b');
+    EXPECT_TRUE(stream.atEnd());
+}
+
+TEST(TestStream, ReadSpan)
+{
+    auto input = std::stringstream{"foo bar,\tbaz;comment\r\n"};
+    auto stream = figcone::shoal::detail::Stream{input};
+    const auto stopChars = figcone::shoal::detail::CharSet{","};
+    EXPECT_EQ(stream.readSpan(stopChars), "foo bar");
+    EXPECT_EQ(stream.position().column, 8);
+    EXPECT_EQ(stream.readSpan(stopChars), "");
+    stream.skip(1);
+    EXPECT_EQ(stream.readSpan(stopChars), "\tbaz");
+    EXPECT_EQ(stream.position().column, 16);
+    EXPECT_EQ(stream.readSpan(stopChars), "");
+    EXPECT_EQ(stream.readChar(), '\n');
+    EXPECT_TRUE(stream.atEnd());
+}
+
+TEST(TestStream, SkipWhile)
+{
+    auto input = std::stringstream{"  \t  foo\n  bar"};
+    auto stream = figcone::shoal::detail::Stream{input};
+    const auto blankChars = figcone::shoal::detail::CharSet{" \t"};
+    stream.skipWhile(blankChars);
+    EXPECT_EQ(stream.position().column, 9);
+    EXPECT_EQ(stream.peekChar(), 'f');
+    stream.skipWhile(blankChars);
+    EXPECT_EQ(stream.peekChar(), 'f');
+    stream.skip(3);
+    stream.skipWhile(blankChars);
+    EXPECT_EQ(stream.readChar(), '\n');
+    stream.skipWhile(blankChars);
+    EXPECT_EQ(stream.peekChar(), 'b');
+}
+
+TEST(TestStream, NonSeekableInput)
+{
+    auto buf = ForwardOnlyBuf{"foo = 1\r\n#a:\r\n  bar = [1, 2] ;comment\n"};
+    auto input = std::istream{&buf};
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.parse(input);
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 1);
+    EXPECT_EQ(tree.param("foo").value(), "1");
+    ASSERT_EQ(tree.nodesCount(), 1);
+    auto& aNode = tree.node("a").asItem();
+    ASSERT_EQ(aNode.paramsCount(), 1);
+    EXPECT_EQ(aNode.param("bar").valueList(), (std::vector<std::string>{"1", "2"}));
+}
+
+TEST(TestStream, InputLargerThanFetchBlock)
+{
+    auto config = "foo = 1 ;" + std::string(100000, 'x') + "\r\n";
+    config += "bar = '" + std::string(70000, 'y') + "'\n";
+    auto input = std::stringstream{config};
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.parse(input);
+
+    auto& tree = result.root().asItem();
+    ASSERT_EQ(tree.paramsCount(), 2);
+    EXPECT_EQ(tree.param("foo").value(), "1");
+    EXPECT_EQ(tree.param("bar").value(), std::string(70000, 'y'));
+}
+
+TEST(TestStream, PositionOfDiscardedData)
+{
+    auto config = std::string{"foo = 1\r\n"};
+    for (auto i = 0; i < 20000; ++i)
+        config += "\tbar = 2\r\n";
+    config += "\tbaz = \n";
+    auto input = std::stringstream{config};
+    auto stream = figcone::shoal::detail::Stream{input};
+    stream.skip(4);
+    const auto offset = stream.offset();
+    while (!stream.atEnd())
+        stream.skip(1);
+
+    EXPECT_EQ(stream.position(offset).line, 1);
+    EXPECT_EQ(stream.position(offset).column, 5);
+    EXPECT_EQ(stream.position().line, 20003);
+    EXPECT_EQ(stream.position().column, 1);
+}
+
+TEST(TestLineIndex, Position)
+{
+    auto index = figcone::shoal::detail::LineIndex{};
+    const auto text = std::string_view{"ab\r\n\tc\rd\n\n\te\r"};
+    index.extend(text.substr(0, 3));
+    index.extend(text.substr(3, 6));
+    index.extend(text.substr(9));
+    ASSERT_EQ(index.size(), text.size());
+
+    const auto check = [&](std::size_t offset, int line, int column)
+    {
+        const auto position = index.position(offset);
+        EXPECT_EQ(position.line, line) << "offset: " << offset;
+        EXPECT_EQ(position.column, column) << "offset: " << offset;
+    };
+    check(0, 0, 0);
+    check(1, 0, 1);
+    check(2, 0, 2);
+    check(4, 1, 0);
+    check(5, 1, 4);
+    check(6, 1, 5);
+    check(7, 2, 0);
+    check(9, 3, 0);
+    check(10, 4, 0);
+    check(11, 4, 4);
+    check(13, 5, 0);
+}
+
+} //namespace test_stream
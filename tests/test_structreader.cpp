@@ -0,0 +1,185 @@
+#include "assert_exception.h"
+#include "structreader/serverconfig.h"
+#include <figcone_shoal/structgenerator.h>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace test_structreader {
+
+std::string readFile(const std::filesystem::path& path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    auto stream = std::stringstream{};
+    stream << file.rdbuf();
+    return stream.str();
+}
+
+void expectError(const std::string& config, const std::string& message)
+{
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                parseServerConfig(config);
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, message);
+            });
+}
+
+void expectSchemaError(const std::string& schema, const std::string& message)
+{
+    assert_exception<figcone::ConfigError>(
+            [&]
+            {
+                figcone::shoal::generateStructReader(schema);
+            },
+            [&](const figcone::ConfigError& error)
+            {
+                EXPECT_EQ(std::string{error.what()}, message);
+            });
+}
+
+// Regenerate with: shoalgen tests/structreader/serverconfig.shoal tests/structreader/serverconfig.h
+TEST(TestStructReader, GeneratedHeaderIsUpToDate)
+{
+    const auto directory = std::filesystem::path{__FILE__}.parent_path() / "structreader";
+    EXPECT_EQ(
+            figcone::shoal::generateStructReader(readFile(directory / "serverconfig.shoal")),
+            readFile(directory / "serverconfig.h"));
+}
+
+TEST(TestStructReader, Read)
+{
+    const auto config = parseServerConfig(R"(
+name = main
+verbose = true
+timeout = 1.5
+tags = [a, "b c"]
+#endpoint:
+  host = localhost
+  port = 8080
+-
+#replicas:
+###
+  host = first
+  port = 1
+###
+  host = second
+  port = 2
+---
+#tls:
+  certificate = cert.pem
+)");
+    EXPECT_EQ(config.name, "main");
+    EXPECT_FALSE(config.threads);
+    EXPECT_TRUE(config.verbose);
+    EXPECT_DOUBLE_EQ(config.timeout, 1.5);
+    EXPECT_EQ(config.tags, (std::vector<std::string>{"a", "b c"}));
+    EXPECT_FALSE(config.ports);
+    EXPECT_EQ(config.endpoint.host, "localhost");
+    EXPECT_EQ(config.endpoint.port, 8080);
+    ASSERT_EQ(config.replicas.size(), 2u);
+    EXPECT_EQ(config.replicas[0].host, "first");
+    EXPECT_EQ(config.replicas[0].port, 1);
+    EXPECT_EQ(config.replicas[1].host, "second");
+    EXPECT_EQ(config.replicas[1].port, 2);
+    ASSERT_TRUE(config.tls);
+    EXPECT_EQ(config.tls->certificate, "cert.pem");
+    EXPECT_FALSE(config.tls->verifyPeer);
+}
+
+TEST(TestStructReader, ReadOptionalFields)
+{
+    const auto config = parseServerConfig(R"(
+name = main
+threads = 4
+threads = 8
+verbose = 0
+timeout = 2
+tags = x, y
+ports = [80, 443]
+#endpoint:
+  port = 1
+  host = h
+-
+#replicas:
+###
+  host = first
+  port = 1
+)");
+    EXPECT_EQ(config.threads, 4);
+    EXPECT_FALSE(config.verbose);
+    EXPECT_EQ(config.tags, (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(config.ports, (std::vector<unsigned int>{80, 443}));
+    EXPECT_FALSE(config.tls);
+}
+
+TEST(TestStructReader, File)
+{
+    const auto path = std::filesystem::temp_directory_path() / "test_structreader.shoal";
+    {
+        auto file = std::ofstream{path, std::ios::binary};
+        file << "name = main\nverbose = true\ntimeout = 1\ntags = [a]\n"
+                "#endpoint:\n  host = h\n  port = 1\n-\n#replicas:\n###\n  host = first\n  port = 1\n";
+    }
+    const auto config = parseServerConfigFile(path);
+    EXPECT_EQ(config.endpoint.host, "h");
+    EXPECT_EQ(config.replicas.size(), 1u);
+    std::filesystem::remove(path);
+}
+
+TEST(TestStructReader, Errors)
+{
+    const auto endpoint = std::string{"#endpoint:\n  host = h\n  port = 1\n-\n"};
+    const auto replicas = std::string{"#replicas:\n###\n  host = first\n  port = 1\n---\n"};
+    const auto params = std::string{"name = main\nverbose = true\ntimeout = 1\ntags = [a]\n"};
+
+    expectError(params + endpoint + replicas + "unknown = 1\n", "[line:14, column:1] Unknown parameter 'unknown'");
+    expectError(params + endpoint + replicas + "#unknown:\n", "[line:14, column:1] Unknown config node 'unknown'");
+    expectError(params + endpoint + replicas + "#tags:\n", "[line:14, column:1] Unknown config node 'tags'");
+    expectError(params + replicas, "Config node 'endpoint' is missing");
+    expectError("name = main\n" + endpoint + replicas, "Parameter 'verbose' is missing");
+    expectError(params + "#endpoint:\n  host = h\n-\n" + replicas, "[line:5, column:1] Parameter 'port' is missing");
+    expectError("name = [a, b]\n", "[line:1, column:1] Parameter 'name' can't be a list");
+    expectError("tags = a\n", "[line:1, column:1] Parameter 'tags' must be a list");
+    expectError("verbose = yes\n", "[line:1, column:1] Couldn't set parameter 'verbose' value from 'yes'");
+    expectError("#endpoint:\n###\n", "[line:1, column:1] Config node 'endpoint' can't be a node list");
+    expectError("#replicas:\n  host = h\n", "[line:1, column:1] Config node 'replicas' must be a node list");
+}
+
+TEST(TestStructReader, GenerateWithIncludes)
+{
+    const auto header = figcone::shoal::generateStructReader(R"(
+include = [config.h, <other.h>]
+root = Config
+#Config:
+  value = int
+)");
+    EXPECT_NE(header.find("#include \"config.h\"\n#include <other.h>\n"), std::string::npos);
+    EXPECT_EQ(header.find("struct Config"), std::string::npos);
+    EXPECT_NE(header.find("class ConfigReader : public figcone::shoal::StructReaderBase"), std::string::npos);
+    EXPECT_NE(header.find("inline Config parseConfig(std::string_view data)"), std::string::npos);
+}
+
+TEST(TestStructReader, SchemaErrors)
+{
+    expectSchemaError("#A:\n  x = int\n", "Schema parameter 'root' is missing");
+    expectSchemaError("root = B\n#A:\n  x = int\n", "Root struct 'B' isn't declared");
+    expectSchemaError("root = A\n#A:\n  x = long\n", "[line:3, column:3] Unknown type 'long' of field 'x'");
+    expectSchemaError(
+            "root = A\n#A:\n  x = list<optional<int>>\n",
+            "[line:3, column:3] Unknown type 'list<optional<int>>' of field 'x'");
+    expectSchemaError("root = A\n#A:\n  x = int\n  x = int\n", "[line:4, column:3] Field 'x' is already declared");
+    expectSchemaError("root = A\n#A:\n  #B:\n", "[line:3, column:3] Struct definitions can't be nested");
+    expectSchemaError(
+            "root = A\n#A:\n  b = B\n-\n#B:\n  a = list<A>\n",
+            "[line:2, column:1] Struct 'A' contains itself");
+    expectSchemaError("root = A\nversion = 2\n", "[line:2, column:1] Unknown schema parameter 'version'");
+}
+
+} //namespace test_structreader
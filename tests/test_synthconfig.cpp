@@ -0,0 +1,77 @@
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <synthconfig.h>
+#include <sstream>
+#include <string>
+
+namespace test_synthconfig {
+
+void expectValidConfig(const shoal_synth::SynthOptions& options)
+{
+    const auto config = shoal_synth::generateConfig(options);
+    EXPECT_GE(config.size(), options.targetSize);
+    auto parser = figcone::shoal::Parser{};
+    EXPECT_NO_THROW(parser.parse(config)) << "seed: " << options.seed;
+}
+
+TEST(TestSynthConfig, Deterministic)
+{
+    auto options = shoal_synth::SynthOptions{};
+    options.targetSize = 64 * 1024;
+    const auto config = shoal_synth::generateConfig(options);
+    EXPECT_EQ(shoal_synth::generateConfig(options), config);
+
+    auto stream = std::ostringstream{};
+    shoal_synth::generateConfig(options, stream);
+    EXPECT_EQ(stream.str(), config);
+
+    options.seed = 2;
+    EXPECT_NE(shoal_synth::generateConfig(options), config);
+}
+
+TEST(TestSynthConfig, UsesAllConstructs)
+{
+    auto options = shoal_synth::SynthOptions{};
+    options.targetSize = 256 * 1024;
+    const auto config = shoal_synth::generateConfig(options);
+    EXPECT_NE(config.find("\n---\n"), std::string::npos);
+    EXPECT_NE(config.find("--"), std::string::npos);
+    EXPECT_NE(config.find(" -\n"), std::string::npos);
+    EXPECT_NE(config.find("###"), std::string::npos);
+    EXPECT_NE(config.find(" = [\n"), std::string::npos);
+    EXPECT_NE(config.find("; "), std::string::npos);
+    EXPECT_NE(config.find('`'), std::string::npos);
+}
+
+TEST(TestSynthConfig, ValidConfigs)
+{
+    for (auto seed = 1u; seed <= 20u; ++seed) {
+        auto options = shoal_synth::SynthOptions{};
+        options.seed = seed;
+        options.targetSize = 16 * 1024;
+        options.depth = static_cast<int>(seed % 6);
+        options.fanout = static_cast<int>(seed % 4) + 1;
+        options.listLength = static_cast<int>(seed % 5);
+        options.commentDensity = seed % 3 ? 0.1 : 0.9;
+        options.quotedValues = seed % 2 ? 0.3 : 1.0;
+        options.nodeLists = seed % 4 ? 0.25 : 0.9;
+        options.paramLists = seed % 5 ? 0.15 : 0.9;
+        options.lineEnding = static_cast<shoal_synth::LineEnding>(seed % 3);
+        expectValidConfig(options);
+    }
+}
+
+TEST(TestSynthConfig, LineEndings)
+{
+    auto options = shoal_synth::SynthOptions{};
+    options.targetSize = 16 * 1024;
+    options.lineEnding = shoal_synth::LineEnding::CR;
+    EXPECT_EQ(shoal_synth::generateConfig(options).find('\n'), std::string::npos);
+
+    options.lineEnding = shoal_synth::LineEnding::CRLF;
+    const auto config = shoal_synth::generateConfig(options);
+    for (auto pos = config.find('\n'); pos != std::string::npos; pos = config.find('\n', pos + 1))
+        ASSERT_EQ(config[pos - 1], '\r');
+}
+
+} //namespace test_synthconfig
@@ -0,0 +1,96 @@
+#include <figcone_shoal/parser.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace test_tryparse {
+
+std::string parseError(std::string_view str)
+{
+    auto parser = figcone::shoal::Parser{};
+    try {
+        parser.parse(str);
+    }
+    catch (const figcone::ConfigError& e) {
+        return e.what();
+    }
+    return {};
+}
+
+std::string errorText(const figcone::shoal::ParseError& error)
+{
+    return figcone::ConfigError{error.message, error.position}.what();
+}
+
+TEST(TestTryParse, Tree)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto result = parser.tryParse(R"(
+foo = 5
+#a:
+  bar = [1, 2]
+-
+#list:
+###
+  x = 1
+)");
+    ASSERT_TRUE(result);
+    auto& tree = result->root().asItem();
+    EXPECT_EQ(tree.param("foo").value(), "5");
+    EXPECT_EQ(tree.node("a").asItem().param("bar").valueList().size(), 2u);
+    EXPECT_EQ(tree.node("list").asList().size(), 1);
+}
+
+TEST(TestTryParse, StreamInput)
+{
+    auto parser = figcone::shoal::Parser{};
+    auto input = std::stringstream{"#a:\nfoo = 1\n"};
+    auto result = parser.tryParse(input);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ(result.value().root().asItem().node("a").asItem().param("foo").value(), "1");
+
+    auto invalidInput = std::stringstream{"#a:\nfoo\n"};
+    const auto invalidResult = parser.tryParse(invalidInput);
+    ASSERT_FALSE(invalidResult.hasValue());
+    EXPECT_EQ(
+            invalidResult.error().message,
+            "Wrong param 'foo' format: parameter's value must be placed on the same line as its name");
+}
+
+TEST(TestTryParse, Error)
+{
+    auto parser = figcone::shoal::Parser{};
+    const auto result = parser.tryParse("#a:\n  foo = 1\n  #b:\n    bar = 'x\n");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error().message, "String isn't closed");
+    EXPECT_EQ(result.error().position.line, 4);
+    EXPECT_EQ(result.error().position.column, 11);
+}
+
+TEST(TestTryParse, SameErrorsAsParse)
+{
+    const auto configs = {
+            "foo\n",
+            "foo = \n",
+            "foo = 1, \n",
+            "foo = [1, 2\nbar = 3",
+            "foo = [1, 2] 3\n",
+            "#a:\n-\n#a:\n",
+            "#:\n",
+            "#a: b\n",
+            "#a:\n--b\n",
+            "#a:\n-x\n",
+            "#a:\n---x\n",
+            "#list:\n### x\n",
+            "#list:\n###\n  foo = 'x\n",
+            "#a:\n  #b:\n    #c:\n      --d\n"};
+    auto parser = figcone::shoal::Parser{};
+    for (const auto config : configs) {
+        const auto result = parser.tryParse(config);
+        ASSERT_FALSE(result) << config;
+        EXPECT_EQ(errorText(result.error()), parseError(config)) << config;
+    }
+}
+
+} //namespace test_tryparse
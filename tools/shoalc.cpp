@@ -0,0 +1,22 @@
+#include <figcone_shoal/parser.h>
+#include <figcone_tree/errors.h>
+#include <iostream>
+
+// Compiles a shoal config into the binary image loaded by figcone::shoal::Parser::loadCompiledFile()
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "Usage: shoalc <config.shoal> <output.shoalbin>" << std::endl;
+        return 1;
+    }
+
+    try {
+        auto parser = figcone::shoal::Parser{};
+        parser.compileFile(argv[1], argv[2]);
+    }
+    catch (const figcone::ConfigError& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
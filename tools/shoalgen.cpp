@@ -0,0 +1,37 @@
+#include <figcone_shoal/structgenerator.h>
+#include <figcone_tree/errors.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Generates a C++ header with a reader parsing shoal configs into the structs described by the schema,
+// see figcone::shoal::generateStructReader()
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "Usage: shoalgen <schema.shoal> <output.h>" << std::endl;
+        return 1;
+    }
+
+    auto schemaFile = std::ifstream{argv[1], std::ios::binary};
+    if (!schemaFile) {
+        std::cerr << "Can't open schema file '" << argv[1] << "' for reading" << std::endl;
+        return 1;
+    }
+    auto schema = std::stringstream{};
+    schema << schemaFile.rdbuf();
+
+    try {
+        const auto header = figcone::shoal::generateStructReader(schema.str());
+        auto outputFile = std::ofstream{argv[2], std::ios::binary};
+        if (!(outputFile << header)) {
+            std::cerr << "Can't write output file '" << argv[2] << "'" << std::endl;
+            return 1;
+        }
+    }
+    catch (const figcone::ConfigError& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
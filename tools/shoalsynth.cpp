@@ -0,0 +1,117 @@
+#include "synthconfig.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace {
+
+void printUsage()
+{
+    std::cerr << "Usage: shoalsynth [options] [output.shoal]\n"
+                 "Writes a generated shoal config to the file or to stdout.\n"
+                 "  --seed <n>           random seed (1)\n"
+                 "  --size <n>[K|M|G]    size of the output (1M)\n"
+                 "  --depth <n>          nesting depth of the config nodes (3)\n"
+                 "  --fanout <n>         child nodes of every node (3)\n"
+                 "  --params <n>         params of every node (6)\n"
+                 "  --list-length <n>    elements of the node lists and param lists (4)\n"
+                 "  --value-length <n>   length of the param values (10)\n"
+                 "  --comments <share>   share of the lines with comments (0.1)\n"
+                 "  --quoted <share>     share of the quoted values (0.3)\n"
+                 "  --node-lists <share> share of the child nodes that are node lists (0.25)\n"
+                 "  --param-lists <share> share of the params that are lists (0.15)\n"
+                 "  --line-ending <lf|crlf|cr> (lf)"
+              << std::endl;
+}
+
+std::uint64_t readSize(const std::string& value)
+{
+    auto suffixPos = std::size_t{};
+    auto size = std::stoull(value, &suffixPos);
+    const auto suffix = value.substr(suffixPos);
+    if (suffix == "K")
+        size <<= 10;
+    else if (suffix == "M")
+        size <<= 20;
+    else if (suffix == "G")
+        size <<= 30;
+    else if (!suffix.empty())
+        throw std::invalid_argument{"size suffix"};
+    return size;
+}
+
+shoal_synth::LineEnding readLineEnding(const std::string& value)
+{
+    const auto lineEndings = std::map<std::string, shoal_synth::LineEnding>{
+            {"lf", shoal_synth::LineEnding::LF},
+            {"crlf", shoal_synth::LineEnding::CRLF},
+            {"cr", shoal_synth::LineEnding::CR}};
+    return lineEndings.at(value);
+}
+
+} //namespace
+
+// Generates shoal configs of the requested size and shape for benchmarks and stress tests
+int main(int argc, char** argv)
+{
+    auto options = shoal_synth::SynthOptions{};
+    auto outputPath = std::string{};
+    try {
+        for (auto i = 1; i < argc; ++i) {
+            const auto arg = std::string{argv[i]};
+            if (arg.rfind("--", 0) != 0) {
+                if (!outputPath.empty())
+                    throw std::invalid_argument{arg};
+                outputPath = arg;
+                continue;
+            }
+            if (i + 1 == argc)
+                throw std::invalid_argument{arg};
+            const auto value = std::string{argv[++i]};
+            if (arg == "--seed")
+                options.seed = std::stoull(value);
+            else if (arg == "--size")
+                options.targetSize = readSize(value);
+            else if (arg == "--depth")
+                options.depth = std::stoi(value);
+            else if (arg == "--fanout")
+                options.fanout = std::stoi(value);
+            else if (arg == "--params")
+                options.paramsPerNode = std::stoi(value);
+            else if (arg == "--list-length")
+                options.listLength = std::stoi(value);
+            else if (arg == "--value-length")
+                options.valueLength = std::stoi(value);
+            else if (arg == "--comments")
+                options.commentDensity = std::stod(value);
+            else if (arg == "--quoted")
+                options.quotedValues = std::stod(value);
+            else if (arg == "--node-lists")
+                options.nodeLists = std::stod(value);
+            else if (arg == "--param-lists")
+                options.paramLists = std::stod(value);
+            else if (arg == "--line-ending")
+                options.lineEnding = readLineEnding(value);
+            else
+                throw std::invalid_argument{arg};
+        }
+    }
+    catch (const std::exception&) {
+        printUsage();
+        return 1;
+    }
+
+    if (outputPath.empty()) {
+        shoal_synth::generateConfig(options, std::cout);
+        return std::cout ? 0 : 1;
+    }
+    auto output = std::ofstream{outputPath, std::ios::binary};
+    shoal_synth::generateConfig(options, output);
+    if (!output) {
+        std::cerr << "Can't write output file '" << outputPath << "'" << std::endl;
+        return 1;
+    }
+    return 0;
+}